@@ -26,6 +26,8 @@ public:
     void hw_serial_begin(uint32_t baud) override;
     void hw_serial_write(const char* s) override;
     void hw_serial_writeln(const char* s) override;
+    int16_t     hw_serial_read() override;
+    hw_status_t hw_serial_write_bytes(const uint8_t* data, uint16_t len) override;
 
 
 protected:
@@ -10,6 +10,15 @@ public:
     // ----- GPIO -----
     hw_status_t hw_pin_attach(const pin_t& pin) override;
 
+    // Direct port access for attached pins (digitalWrite path for the others)
+    hw_status_t hw_pin_write(uint8_t pin, hw_pin_value_t value) override;
+    hw_status_t hw_pin_read(uint8_t pin, hw_pin_value_t* value) override;
+    hw_status_t hw_pin_toggle(uint8_t pin) override;
+
+    // ----- Ports -----
+    bool        hw_pin_port(uint8_t pin, uint8_t* port, uint32_t* mask) const override;
+    hw_status_t hw_port_write_masked(uint8_t port, uint32_t mask, uint32_t value) override;
+
 protected:
     // ---- GPIO hooks ----
     hw_status_t hw_pin_validate(const pin_t& pin) override;
@@ -23,6 +32,13 @@ private:
     static constexpr uint8_t HW_MAX_PINS = 70;
     static  ArduinoBoard::hw_pin_meta_t s_gpio_pins[HW_MAX_PINS]; // declaration
     hw_pin_meta_t* hw_pin_get_meta(uint8_t pin);      
+
+    // Hot-path view of an attached pin, resolved once from hw_pin_meta_t at attach
+    struct hw_pin_fast_t {
+        volatile uint8_t* out;  // PORTx (nullptr = not attached); PINx = out - 2
+        uint8_t           mask; // 1 << bit
+    };
+    static hw_pin_fast_t s_gpio_fast[HW_MAX_PINS];
     
 };
 
@@ -30,6 +30,24 @@ public:
 
     uint8_t pin_to_index(const pin_t& pin) const {return hw_pin_to_index(pin);}
 
+    // ----- Port Functions (optional capability) -----
+    // Several pins of one port in a single, atomic operation. Boards that can't do it
+    // keep the defaults; callers then fall back to hw_pin_write per pin.
+    // port / mask are board-specific and come from hw_pin_port() on attached pins.
+    virtual bool        hw_pin_port(uint8_t /*pin*/, uint8_t* /*port*/, uint32_t* /*mask*/) const { return false; }
+    virtual hw_status_t hw_port_write_masked(uint8_t /*port*/, uint32_t /*mask*/, uint32_t /*value*/) { return HW_ERROR; }
+
+    // ----- Parallel data bus (optional capability) -----
+    // 16-bit words onto the DDS data port D[15:0], one every period_ns, moved by a timer ISR or
+    // a DMA channel (boards that route PDCLK to a trigger input may pace it from there).
+    // Runs in the background: start returns at once and position counts the words put on the
+    // bus so far. circular goes back to words[0] after the last word, otherwise the bus keeps
+    // the last one. The buffer must outlive the transfer. Boards without a bus keep the defaults.
+    virtual hw_status_t hw_parallel_start(const uint16_t* /*words*/, uint32_t /*count*/,
+                                          uint32_t /*period_ns*/, bool /*circular*/) { return HW_ERROR; }
+    virtual hw_status_t hw_parallel_stop() { return HW_ERROR; }
+    virtual uint32_t    hw_parallel_position() const { return 0; }
+
     // ----- SPI Functions -----
     virtual hw_status_t hw_spi_init(const spi_config_t& cfg)= 0;
     virtual hw_status_t hw_spi_reset() = 0;
@@ -47,6 +65,12 @@ public:
     virtual void hw_serial_write(const char* ) {} 
     virtual void hw_serial_writeln(const char* s) { hw_serial_write(s); hw_serial_write("\r\n"); }
 
+    // ----- Serial / binary link (optional capability) -----
+    // Raw bytes for the framed host protocol (dds/dds_protocol.h). Non-blocking read:
+    // next received byte, -1 when the RX buffer is empty. Boards without it keep the defaults.
+    virtual int16_t     hw_serial_read() { return -1; }
+    virtual hw_status_t hw_serial_write_bytes(const uint8_t* /*data*/, uint16_t /*len*/) { return HW_ERROR; }
+
     // ======================== Destructor ========================
     virtual ~HWAbstraction() = default;
 
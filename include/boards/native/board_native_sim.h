@@ -0,0 +1,226 @@
+#pragma once
+#include "boards/board_abstraction.h"
+#include "dds/ad9910/ad9910_pins.h"
+#include "dds/ad9910/ad9910_registers.h"
+
+// Software-emulated AD9910 behind the HWAbstraction interface (env:native).
+//
+// Every GPIO / SPI call the driver makes is decoded the way the chip would see it:
+//  - SPI bytes clocked while SPI_CS is low are parsed as [instruction][payload] frames
+//    into the STAGED (I/O buffer) register bank.
+//  - A rising edge on IO_UPDATE copies the staged bank into the ACTIVE bank.
+//  - A rising edge on MASTER_RESET restores both banks to the power-on defaults.
+//  - PROFILE0..2 levels select the active profile.
+//  - RAM (0x16) frames fill the address range of the selected, active RAM profile.
+//  - The parallel bus presents one word per period on the virtual clock; with CFR2[4] set
+//    and TX_ENABLE high the chip applies it to the destination picked by F[1:0].
+// Reads return the active bank.
+//
+// On top of that, a virtual clock is advanced by a simple cost model so that host-side
+// tests can measure bytes-per-update and update latency without a scope.
+class NativeSimBoard : public HWAbstraction {
+public:
+
+    // Cost of each HW operation in CPU cycles (defaults ≈ ATmega2560 @16 MHz + Arduino core)
+    struct sim_cost_model_t {
+        uint32_t cpu_hz;            // converts cycles → ns
+        uint16_t pin_write_cycles;  // one hw_pin_write / hw_pin_read / hw_pin_toggle
+        uint16_t spi_call_cycles;   // fixed overhead of one hw_spi_* call (transaction setup)
+        uint16_t spi_byte_cycles;   // per byte overhead on top of the 8 SCLK periods
+    };
+
+    struct sim_stats_t {
+        uint64_t time_ns;                   // virtual time since construction / last reset
+        uint32_t hw_calls;                  // every virtual HWAbstraction entry point
+        uint32_t pin_writes;
+        uint32_t spi_calls;
+        uint32_t spi_bytes;
+        uint32_t cs_assertions;             // CS falling edges
+        uint32_t frames;                    // completed register writes
+        uint32_t reads;                     // completed register reads
+        uint32_t io_updates;                // IO_UPDATE rising edges
+        uint32_t protocol_errors;           // reserved address / frame cut by CS
+        uint32_t port_writes;               // hw_port_write_masked calls
+        uint32_t profile_changes;           // PROFILE[2:0] transitions seen by the chip (glitches included)
+        uint32_t master_resets;
+        uint32_t serial_rx_bytes;           // bytes the firmware read (hw_serial_read)
+        uint32_t serial_tx_bytes;           // bytes the firmware sent (hw_serial_write_bytes)
+        uint32_t last_update_bytes;         // SPI bytes between the two last IO_UPDATEs
+        uint64_t last_update_latency_ns;    // first CS low after the previous IO_UPDATE → this IO_UPDATE
+    };
+
+    static constexpr sim_cost_model_t kMegaCostModel = { 16000000u, 56u, 40u, 4u };
+
+    // pins: how this chip is wired (dds_pins_with_cs for one chip of a DdsArray)
+    explicit NativeSimBoard(const sim_cost_model_t& cost = kMegaCostModel,
+                            const std::array<pin_t, kPinCount>& pins = dds_pins());
+    ~NativeSimBoard() override = default;
+
+    // ----- GPIO Functions -----
+    hw_status_t hw_pin_attach(const pin_t& pin) override;
+    hw_status_t hw_pin_mode(uint8_t pin, pin_mode_t mode) override;
+    hw_status_t hw_pin_write(uint8_t pin, hw_pin_value_t value) override;
+    hw_status_t hw_pin_read(uint8_t pin, hw_pin_value_t* value) override;
+    hw_status_t hw_pin_toggle(uint8_t pin) override;
+
+    // ----- Ports (virtual port = 8 pins, index = port * 8 + bit) -----
+    bool        hw_pin_port(uint8_t pin, uint8_t* port, uint32_t* mask) const override;
+    hw_status_t hw_port_write_masked(uint8_t port, uint32_t mask, uint32_t value) override;
+
+    // ----- SPI Functions -----
+    hw_status_t hw_spi_init(const spi_config_t& cfg) override;
+    hw_status_t hw_spi_reset() override;
+    hw_status_t hw_spi_transfer(const uint8_t* tx_data, uint8_t* rx_data, uint16_t len) override;
+    hw_status_t hw_spi_write(const uint8_t* data, uint16_t len) override;
+    hw_status_t hw_spi_read(uint8_t* data, uint16_t len) override;
+
+    // ----- Delays -----
+    void hw_delay_us(uint32_t us) override;
+    void hw_delay_ms(uint32_t ms) override;
+
+    // ----- Parallel bus (words advance with the virtual clock) -----
+    hw_status_t hw_parallel_start(const uint16_t* words, uint32_t count, uint32_t period_ns, bool circular) override;
+    hw_status_t hw_parallel_stop() override;
+    uint32_t    hw_parallel_position() const override;
+
+    // ----- Serial (loopback: the host end is sim_serial_inject / sim_serial_take) -----
+    int16_t     hw_serial_read() override;
+    hw_status_t hw_serial_write_bytes(const uint8_t* data, uint16_t len) override;
+
+    // What the DDS core runs on: FTW / POW / ASF after the parallel port (if enabled)
+    struct sim_core_t {
+        uint32_t ftw;
+        uint16_t pow;
+        uint16_t asf;
+    };
+
+    // ======================== Simulator inspection ========================
+    const sim_stats_t& sim_stats() const { return stats_; }
+    void     sim_reset_stats();
+    uint64_t sim_time_ns() const { return stats_.time_ns; }
+
+    uint64_t sim_active(ad9910_reg::Reg reg) const;     // big-endian register value
+    uint64_t sim_staged(ad9910_reg::Reg reg) const;
+    uint8_t  sim_profile() const;                       // PROFILE[2:0] pin levels
+    uint32_t sim_ram(uint16_t addr) const;              // RAM word (addr 0..1023)
+    uint16_t sim_parallel_word() const;                 // D[15:0] now
+    sim_core_t sim_core() const;                        // single tone / parallel port, active bank
+    bool     sim_pin_level(const pin_t& pin) const;
+    bool     sim_pin_output(const pin_t& pin) const;     // direction as last set by hw_pin_mode
+    void     sim_set_pin_level(const pin_t& pin, bool high);  // drive an input (DROVER, PLL_LOCK, ...)
+    void     sim_serial_inject(const uint8_t* data, size_t len);  // host → firmware RX queue
+    size_t   sim_serial_take(uint8_t* out, size_t max);           // firmware TX → host, oldest first
+    size_t   sim_serial_rx_pending() const { return serial_rx_.size() - serial_rx_head_; }
+
+protected:
+    // ---- GPIO hooks ----
+    hw_status_t hw_pin_validate(const pin_t& pin) override;
+    uint8_t     hw_pin_to_index(const pin_t& pin) const override;
+    void*       hw_port_base_from_index(uint8_t port_ix) const override;
+
+    // ---- SPI hooks ----
+    hw_status_t hw_spi_validate_config(const spi_config_t& cfg) override;
+    hw_status_t hw_spi_config() override;
+    uint8_t     hw_spi_mode() const override;
+
+private:
+    // Virtual MCU: 12 ports (A..L) × 8 bits, index = port * 8 + bit
+    static constexpr uint8_t HW_PORT_COUNT = PORT_UNKNOWN;
+    static constexpr uint8_t HW_MAX_PINS   = HW_PORT_COUNT * 8;
+    static constexpr uint8_t REG_MAX_LEN   = 8;
+    static constexpr uint16_t RAM_WORDS    = ad9910_reg::RAM_PROFILE::RAM_WORDS;
+
+    struct sim_bank_t { uint8_t r[ad9910_reg::REG_COUNT][REG_MAX_LEN]; };
+
+    // Serial port controller state
+    enum class spi_phase_t : uint8_t { INSTRUCTION, DATA };
+
+    sim_cost_model_t cost_;
+    std::array<pin_t, kPinCount> pins_;
+    spi_config_t     cfg_{};
+    bool             initialized_ = false;
+    sim_stats_t      stats_{};
+
+    uint8_t port_out_[HW_PORT_COUNT] = {};
+    uint8_t port_dir_[HW_PORT_COUNT] = {};
+
+    // Resolved once in the constructor from dds_pins()
+    uint8_t cs_ix_, io_update_ix_, master_reset_ix_, io_reset_ix_;
+    uint8_t profile_ix_[3];
+
+    sim_bank_t  staged_{};
+    sim_bank_t  active_{};
+    uint8_t     ram_[RAM_WORDS][4] = {};    // big-endian words
+    spi_phase_t phase_     = spi_phase_t::INSTRUCTION;
+    uint8_t     cur_addr_  = 0;
+    uint16_t    cur_len_   = 0;             // payload bytes of the current frame (RAM: 4 × words)
+    uint16_t    cur_pos_   = 0;
+    uint16_t    ram_start_ = 0;             // RAM frame: first word address
+    bool        cur_read_  = false;
+
+    uint8_t     last_profile_ = 0;
+
+    const uint16_t* par_words_    = nullptr;    // the board's buffer, as a DMA would read it
+    uint32_t        par_count_    = 0;
+    uint32_t        par_period_ns_= 0;
+    int64_t         par_t0_       = 0;          // virtual time of word 0 (sim_reset_stats rebases)
+    uint32_t        par_stopped_  = 0;          // position when stopped
+    bool            par_circular_ = false;
+    bool            par_running_  = false;
+
+    std::vector<uint8_t> serial_rx_;            // injected, not yet read
+    size_t               serial_rx_head_ = 0;
+    std::vector<uint8_t> serial_tx_;            // written, not yet taken
+
+    bool        update_window_open_ = false;    // a CS assertion happened since the last IO_UPDATE
+    uint64_t    update_window_t0_   = 0;
+    uint32_t    update_window_bytes_= 0;
+
+    static uint8_t index_of(const pin_t& pin);
+    bool  level(uint8_t ix) const { return (port_out_[ix >> 3] >> (ix & 7)) & 1u; }
+    void  set_level(uint8_t ix, bool high);
+    void  on_edge(uint8_t ix, bool high);
+    void  note_profile();
+    void  reset_banks();
+    uint8_t spi_clock_byte(uint8_t mosi);
+    void  advance_cycles(uint32_t cycles);
+    uint64_t reg_value(const sim_bank_t& bank, ad9910_reg::Reg reg) const;
+};
+
+
+// Several simulated AD9910s behind one MCU (DdsArray). This board is chip 0; every GPIO, SPI
+// and delay call is repeated on the attached chips, so all of them see the same pin levels,
+// the same bytes on SCLK / SDIO and the same virtual time. Each decodes SPI only while its
+// own CS is low. Reads OR the chips' SDO bytes (only the selected one drives it).
+class NativeSimBus : public NativeSimBoard {
+public:
+    static constexpr uint8_t MAX_CHIPS = 8;
+
+    using NativeSimBoard::NativeSimBoard;
+
+    bool            sim_attach(NativeSimBoard& chip);           // false when MAX_CHIPS are in
+    uint8_t         sim_chip_count() const { return uint8_t(1u + extra_); }
+    NativeSimBoard& sim_chip(uint8_t i) { return i == 0 ? static_cast<NativeSimBoard&>(*this) : *chips_[i - 1u]; }
+    void            sim_reset_stats_all();
+
+    hw_status_t hw_pin_attach(const pin_t& pin) override;
+    hw_status_t hw_pin_mode(uint8_t pin, pin_mode_t mode) override;
+    hw_status_t hw_pin_write(uint8_t pin, hw_pin_value_t value) override;
+    hw_status_t hw_pin_toggle(uint8_t pin) override;
+    hw_status_t hw_port_write_masked(uint8_t port, uint32_t mask, uint32_t value) override;
+
+    hw_status_t hw_spi_init(const spi_config_t& cfg) override;
+    hw_status_t hw_spi_reset() override;
+    hw_status_t hw_spi_transfer(const uint8_t* tx_data, uint8_t* rx_data, uint16_t len) override;
+    hw_status_t hw_spi_write(const uint8_t* data, uint16_t len) override;
+    hw_status_t hw_spi_read(uint8_t* data, uint16_t len) override;
+
+    void hw_delay_us(uint32_t us) override;
+    void hw_delay_ms(uint32_t ms) override;
+
+private:
+    NativeSimBoard* chips_[MAX_CHIPS - 1] = {};
+    uint8_t         extra_ = 0;
+
+    void or_reads(NativeSimBoard& chip, const uint8_t* tx, uint8_t* rx, uint16_t len);
+};
@@ -23,4 +23,4 @@ using std::int64_t;
         (status_var) = (expr);                          \
         if ((status_var) != dds_status_t::DDS_OK)       \
             return (return_value);                      \
-    } while (0)
\ No newline at end of file
+    } while (0)
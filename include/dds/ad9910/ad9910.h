@@ -6,6 +6,9 @@
 #include "ad9910_context.h"
 #include "ad9910_pins.h"
 #include "ad9910_registers.h"
+#include "ad9910_reg_cache.h"
+#include "ad9910_reg_batch.h"
+#include "ad9910_math.h"
 
 
 // Expected SPI CONFIG
@@ -20,12 +23,16 @@ class AD9910 final : public DDSBase {
 public:
     
     // --- Constructor ---
+    // pins: one entry per DdsPin, kept by address (must outlive the driver)
     explicit AD9910(HWAbstraction& hw,
                 const HWAbstraction::spi_config_t& spi_cfg,
-                const AD9910Context& ad9910_ctx);
+                const AD9910Context& ad9910_ctx,
+                const std::array<pin_t, kPinCount>& pins = dds_pins());
 
     // --- AD9910-specifics : Base Overrides ---
-    uint32_t dds_freq_ftw(uint32_t freq_hz) const override;
+    uint32_t dds_freq_ftw(uint32_t freq_hz) const override;         // multiply-shift, no division
+    void dds_freq_ftw_batch(const uint32_t* freq_hz,                  // whole frequency list → FTWs
+                            uint32_t* ftw_out, size_t n) const override;   // (SIMD on the host)
     dds_status_t dds_freq_single(uint8_t profile_index,
                                      uint32_t freq_hz,
                                      int16_t amplitude_db) override; 
@@ -36,36 +43,274 @@ public:
                                 SweepTimeFormat fmt,
                                 bool continuous) override;
 
+    // What the last dds_freq_sweep actually programmed (ad9910_math::drg_fit)
+    struct sweep_report_t {
+        uint32_t ftw_step;
+        uint16_t step_rate;
+        uint64_t achieved_ns;
+        int64_t  duration_error_ns;     // achieved − requested
+        int32_t  end_freq_error_mhz;    // FTW(stop) as output − stop_hz, in mHz
+    };
+    const sweep_report_t& dds_last_sweep() const { return last_sweep_; }
+
     // --- AD9910-specifics : Extra Functionalities ---
-    void calc_best_step_rate(uint16_t& step,
+    bool calc_best_step_rate(uint16_t& step,
                                 uint64_t& step_rate,
                                 uint32_t f_mod_hz) const;
 
+    // Free-running DRG frequency ramp with independent slopes, set up once and left to the
+    // chip. rise_ns / fall_ns go through drg_fit on each side (0 = one DRG tick, i.e. a jump).
+    //   triangle / asymmetric : nodwell_high = nodwell_low = true
+    //   sawtooth up           : same with fall_ns = 0 (down: rise_ns = 0, start_up = false)
+    //   one-shot              : both false, DRCTL then moves it (dwells at each limit)
+    //   snap-back one-shot    : one no-dwell bit, a new ramp per DRCTL edge
+    struct freq_ramp_t {
+        uint32_t low_hz;
+        uint32_t high_hz;
+        uint64_t rise_ns;
+        uint64_t fall_ns;
+        bool     nodwell_high;
+        bool     nodwell_low;
+        bool     start_up;          // DRCTL level at start
+    };
+    // Achieved slope durations written back to rise_ns / fall_ns when achieved is given
+    dds_status_t dds_freq_ramp(const freq_ramp_t& ramp, freq_ramp_t* achieved = nullptr);
+
+    // Same ramp on any DRG destination, limits in that destination's own word:
+    // FTW (32 bit), POW (16 bit) or ASF (14 bit), scaled up to the accumulator's MSBs here.
+    // For phase / amplitude the other parameters come from PROFILE0, loaded with the carrier
+    // FTW (full scale ASF, POW 0).
+    using DrgDest = ad9910_reg::CFR2::DrgDest;
+    struct drg_ramp_t {
+        DrgDest  dest;
+        uint32_t lower;
+        uint32_t upper;
+        uint64_t rise_ns;
+        uint64_t fall_ns;
+        bool     nodwell_high;
+        bool     nodwell_low;
+        bool     start_up;
+    };
+    dds_status_t dds_drg_ramp(const drg_ramp_t& ramp, uint32_t carrier_ftw = 0, drg_ramp_t* achieved = nullptr);
+
+    // AM / PM on the chip: continuous = free-running triangle, else a single rise on DRCTL
+    dds_status_t dds_phase_ramp(uint32_t carrier_hz,
+                                uint32_t from_cdeg,                 // 0.01°, from < to ≤ 360°
+                                uint32_t to_cdeg,
+                                uint64_t rise_ns,
+                                uint64_t fall_ns,
+                                bool continuous);
+    dds_status_t dds_ampl_ramp(uint32_t carrier_hz,
+                               int32_t low_cdb,                     // 0.01 dB, low < high ≤ 0
+                               int32_t high_cdb,
+                               uint64_t rise_ns,
+                               uint64_t fall_ns,
+                               bool continuous);
+
+    // DRG frequency ramp between two FTWs (raw words, see dds_freq_sweep for Hz/time)
+    dds_status_t dds_digital_ramp(uint32_t ftw_start,
+                                  uint32_t ftw_end,
+                                  uint32_t ftw_step,
+                                  uint16_t step_rate,
+                                  bool continuous);
+
+    // Piecewise chirps (SweepPlan): DRG on frequency, accumulator kept across segments
+    dds_status_t dds_drg_chirp_begin(uint32_t ftw_start);            // output parked at ftw_start
+    dds_status_t dds_drg_chirp_segment(const uint8_t* frames,        // precompiled DR_LIMIT/STEP/RATE
+                                       size_t len,                   // frames → IO_UPDATE → DRCTL
+                                       bool up);
+    dds_status_t dds_drover(bool* over);                             // DROVER pin level
+
+    template<typename Profile>
+    dds_status_t dds_freq_out(uint32_t f_out, int16_t ampl_db);
+
+    template<typename Profile>
+    dds_status_t set_profile();
+
+    // --- Single tone profiles by run-time index (0..7) ---
+    static uint16_t dds_ampl_asf(int16_t ampl_db);                   // dB (≤ 0) → 14-bit ASF
+    dds_status_t dds_profile_load(uint8_t index,                     // PROFILEn ← FTW/POW/ASF (staged)
+                                  uint32_t ftw, uint16_t pow, uint16_t asf,
+                                  bool io_update = true);            // make it active now
+    dds_status_t dds_profile_load_raw(uint8_t index,                 // PROFILEn ← 8 precomputed bytes
+                                      const uint8_t* payload,        // (PROFILE0::bytes), no math
+                                      bool io_update = true);
+    dds_status_t dds_profile_select(uint8_t index);                  // PROFILE[2:0] pins only, no SPI
+
+    // --- RAM playback (ad9910_ram.cpp) ---
+    // 1024 × 32-bit words played by the chip itself: frequency, phase, amplitude or polar
+    // modulation at full rate without the MCU in the loop. While RAM is enabled the
+    // PROFILE0..7 registers hold RAM profiles, not single tones.
+    using RamDest = ad9910_reg::CFR1::RamDest;
+    using RamMode = ad9910_reg::RAM_PROFILE::Mode;
+
+    struct ram_profile_t {
+        uint16_t start;             // first word (0..1023)
+        uint16_t end;               // last word (start..1023)
+        uint16_t step_rate;         // time per address = 4 × step_rate / f_SYSCLK (see dds_ram_step_rate)
+        RamMode  mode;
+        bool     no_dwell_high;     // ramp-up: return to start after the last word
+        bool     zero_crossing;     // direct switch: change phase on a zero crossing
+    };
+
+    uint16_t dds_ram_step_rate(uint32_t step_ns) const;                    // ns per word → step_rate (≥ 1)
+    dds_status_t dds_ram_profile(uint8_t index, const ram_profile_t& p);   // RAM profile n (staged)
+    dds_status_t dds_ram_load(uint8_t index,                               // RAM profile n + words[0..end-start]
+                              const ram_profile_t& p,                      // in a single CS assertion
+                              const uint32_t* words);                      // (ad9910_reg::ram_word::*)
+    dds_status_t dds_ram_play(uint8_t index, RamDest dest, uint32_t ftw = 0);   // ftw: carrier when dest ≠ Frequency
+    dds_status_t dds_ram_stop();
+
+    // --- Output shift keying (ad9910_osk.cpp) ---
+    // The OSK pin keys the output with the amplitude held in the ASF register. Automatic: the
+    // chip ramps 0 ↔ ASF in rise_ns on each pin edge; manual: the pin switches at once.
+    // Both start keyed off (pin low). The DRG set-ups rewrite CFR1 and drop OSK.
+    // step_lsb: 1, 2, 4 or 8 ASF LSBs per step, 0 = whichever gives the closest rise time.
+    dds_status_t dds_osk_auto(int32_t ampl_cdb,                      // 0.01 dB, keyed-on level
+                              uint64_t rise_ns,
+                              uint8_t step_lsb = 0,
+                              uint64_t* achieved_ns = nullptr);
+    dds_status_t dds_osk_manual(int32_t ampl_cdb);
+    dds_status_t dds_osk_key(bool on);                               // OSK pin only, no SPI
+    dds_status_t dds_osk_off();                                      // amplitude from the profiles again
+
+    // --- Parallel data port (ad9910_parallel.cpp) ---
+    // 16-bit samples on D[15:0], latched by the chip on every PDCLK (f_SYSCLK / 4) while
+    // TxEnable is high and applied to the destination F[1:0] selects (ParDest, words from
+    // ad9910_reg::par_word). Frequency: FTW register + (word << fm_gain), see
+    // ad9910_math::par_fm_gain. Frequency / phase off the port come from the FTW / POW
+    // registers (cfg.ftw / cfg.pow), amplitude from the selected profile. The MCU side is the
+    // board's parallel bus (timer ISR or DMA, one word per period_ns): modulation far beyond
+    // what SPI writes can reach. DDS_HW_ERROR on boards without one.
+    using ParDest = ad9910_reg::ParDest;
+
+    struct parallel_cfg_t {
+        ParDest  dest;
+        uint32_t ftw;               // carrier, or the base the frequency words add to
+        uint16_t pow;
+        uint8_t  fm_gain;           // 0..15, frequency destination only
+        bool     hold_last;         // TxEnable low: keep the last word (else the port adds 0)
+    };
+
+    dds_status_t dds_parallel_begin(const parallel_cfg_t& cfg);              // port on, TxEnable low
+    dds_status_t dds_parallel_stream(const uint16_t* words, uint32_t count,  // buffer must outlive it
+                                     uint32_t period_ns,                     // ≥ one PDCLK period
+                                     bool circular = false);
+    uint32_t     dds_parallel_position() const;                              // words presented so far
+    dds_status_t dds_parallel_stop();                                        // TxEnable low, bus halted
+    dds_status_t dds_parallel_end();                                         // port off, profiles again
+
+    // --- Transactions (ad9910_transaction.cpp) ---
+    // Stages any number of register writes and makes them active together with a single
+    // IO_UPDATE on commit(), then moves the PROFILE pins if select() was used. Frames go out
+    // in bursts whenever the batch fills: the chip only stages them, so the output does not
+    // change before the pulse (internal I/O update mode latches on its own timer instead).
+    // On an error, or when the scope ends without commit(), the register bank is restored
+    // and whatever already went out is overwritten with the old contents (best effort: the
+    // cache forgets those registers either way), so a later IO_UPDATE can't latch it.
+    // RAM is not staged and is rejected (DDS_INVALID_PARAM).
+    //
+    //   AD9910::Transaction t(dds);
+    //   t.write<ad9910_reg::PROFILE3>(ad9910_reg::PROFILE3::single_tone(ftw, pow, asf));
+    //   t.write(ad9910_reg::fixed::CFR2_DEFAULTS);
+    //   t.select(3);
+    //   return t.commit();
+    class Transaction {
+    public:
+        explicit Transaction(AD9910& dds) : dds_(dds) {}
+        ~Transaction() { if (open_) abort(); }
+        Transaction(const Transaction&)            = delete;
+        Transaction& operator=(const Transaction&) = delete;
+
+        template<typename R>
+        Transaction& write(typename R::value_type v) {
+            const auto f = R::frame(v);
+            return write_raw(R::address, f.data() + 1, static_cast<uint8_t>(R::length));
+        }
+        template<typename R>
+        Transaction& write(const FixedReg<R>& fixed) {
+            return write_raw(R::address, fixed.frame.data() + 1, static_cast<uint8_t>(R::length));
+        }
+        Transaction& write_raw(uint8_t addr, const uint8_t* payload, uint8_t len);
+        Transaction& select(uint8_t profile);                        // PROFILE pins after the pulse
+
+        dds_status_t commit();                                       // the first error, if any
+        void         abort();
+        dds_status_t status() const { return status_; }
+
+    private:
+        dds_status_t send();                                         // batch → chip, no pulse
+        void rollback();
+
+        AD9910&                   dds_;
+        RegisterBatch             batch_;
+        ad9910_reg::RegisterBank  saved_{};                          // bank before the first burst
+        uint32_t                  sent_    = 0;                      // addresses clocked out, by bit
+        dds_status_t              status_  = dds_status_t::DDS_OK;
+        uint8_t                   profile_ = 0xFFu;                  // 0xFF: leave the pins alone
+        bool                      open_    = true;
+    };
+
+    // --- I/O update source ---
+    // External (default): a pulse on the IO_UPDATE pin, high for io_update_pulse_us (context).
+    // Internal: the chip latches staged writes itself every period_ns and drives IO_UPDATE as
+    // an output, so the MCU pin goes to input and dds_update_io_pulse does nothing. CFR2
+    // writes made meanwhile keep the internal bits. Leaving waits out one internal period.
+    dds_status_t dds_io_update_internal(uint64_t period_ns, uint64_t* achieved_ns = nullptr);
+    dds_status_t dds_io_update_external();
+    bool         dds_io_update_is_internal() const { return io_internal_; }
+
+    // --- Register cache ---
+    // Writes whose payload matches what the chip already holds are skipped.
+    // Call after anything that changes the chip behind the driver's back.
+    void dds_reg_cache_invalidate() { reg_cache_.invalidate_all(); }
+
+    // --- Register bank (this device's register image) ---
+    const ad9910_reg::RegisterBank& dds_regs() const { return regs_; }
+    uint64_t dds_sysclk_hz() const;
+
 
 
     
     
 protected:
+    friend class DdsArray;      // shares the bus: init phases, cache and bank of each channel
+
     const AD9910Context     ad9910_ctx_    ;
-    uint64_t dds_sysclk_hz() const;
     dds_status_t dds_restart_drg();
-    bool ref_div2_;   
+    bool ref_div2_ = false;   
     uint64_t sysclk_hz_ = 0; // cached system clock
+    ad9910_math::ftw_recip_t ftw_recip_ = {0, 0, 0};   // 2^32 / sysclk, set with sysclk_hz_
     bool drg_continuous_ = false;   // remember last DRG mode
+    sweep_report_t last_sweep_ = {0, 0, 0, 0, 0};
+    bool     io_internal_  = false;     // internal I/O update timer running (CFR2[23])
+    uint8_t  io_rate_ctrl_ = 0;         // its prescaler code, CFR2[15:14]
+    uint64_t io_period_us_ = 0;         // its period, rounded up
+    void cfr2_io_overlay(uint8_t* payload) const;    // internal I/O update bits into a CFR2 payload
     uint8_t pll_mlt_ = 0;        // cached PLL multiplier
+    uint8_t vco_sel_ = 0;        // cached CFR3 VCO_SEL code (6 = PLL bypass)
+    AD9910RegCache reg_cache_;   // last bytes written per register address
+
+    // PROFILE[2:0] grouped by board port (dds_attach_hook). One masked write per group;
+    // profile_port_count_ == 0 → the board has no port access, pin_write per pin.
+    struct profile_port_t {
+        uint8_t  port;
+        uint32_t mask;              // all PROFILE bits on this port
+        uint32_t bit_mask[3];       // PROFILEk's bit on this port, 0 if on another port
+    };
+    profile_port_t profile_ports_[3] = {};
+    uint8_t        profile_port_count_ = 0;
+    ad9910_reg::RegisterBank regs_ = ad9910_reg::RegisterBank::power_on();   // composed register values
 
     // --- AD9910-specifics : Sequence getters ---
     const DdsSequence* get_seq_setup(size_t& count) const override;
-    const DdsSequence* get_seq_update(size_t& count) const override;
+    void dds_seq_step_hook(const DdsSequence& step) override;   // MASTER_RESET → drop reg_cache_, reset regs_
+    dds_status_t dds_attach_hook() override;                    // groups PROFILE pins by port
 
-    dds_status_t dds_digital_ramp(uint32_t ftw_start,
-                                            uint32_t ftw_end,
-                                            uint32_t ftw_step,
-                                            uint16_t step_rate,
-                                            bool continuous);
     // --- AD9910-specifics : Init Function substeps ---
     dds_status_t dds_validate_context() override; // 🤔
     dds_status_t dds_setup_reg() override; // 
+    void dds_setup_batch(RegisterBatch& b) const;   // CFR1..3 + AUX_DAC as dds_setup_reg writes them
  
     // --- AD9910-specifics : Register programming helpers ----
     dds_status_t dds_reg_write(uint8_t addr,
@@ -90,12 +335,69 @@ protected:
         return dds_reg_read(static_cast<uint8_t>(id), buf, len);
     }
 
-    // Special registers functions
-    dds_status_t dds_program_cfr1();    // ✅🤔
-    dds_status_t dds_program_cfr2();    // ✅🤔
-    dds_status_t dds_program_cfr3();        // NEW
+    // Writes v to register R and, on success, records it in the bank slot
+    template<typename R>
+    dds_status_t dds_reg_commit(typename R::value_type& slot, typename R::value_type v) {
+        const auto b = R::bytes(v);
+        const dds_status_t s = dds_reg_write(static_cast<uint8_t>(R::address), b.data(), b.size());
+        if (s == dds_status_t::DDS_OK) slot = v;
+        return s;
+    }
+
+    // Compile-time configuration: the frame is sent as-is (one spi_tx, no packing)
+    template<typename R>
+    dds_status_t dds_reg_commit(typename R::value_type& slot, const FixedReg<R>& fixed) {
+        const dds_status_t s = dds_reg_write_frame(fixed.frame.data(), fixed.frame.size());
+        if (s == dds_status_t::DDS_OK) slot = fixed.value;
+        return s;
+    }
+
+    // Writes a complete [instruction][payload] frame in a single spi_tx
+    dds_status_t dds_reg_write_frame(const uint8_t* frame, size_t len);
+
+    // Sends every frame of the batch the chip doesn't already hold under one CS
+    // assertion, then records them in reg_cache_ / regs_. The batch is cleared.
+    dds_status_t dds_reg_flush(RegisterBatch& batch);
+
+    // CS low → one spi_tx → CS high, CS resolved once at attach (no per-call lookup)
+    dds_status_t dds_spi_burst(const uint8_t* buf, size_t len);
+
+    // RAM write: instruction 0x16 + count words MSB first under one CS assertion.
+    // The chip fills the address range of the currently selected RAM profile.
+    dds_status_t dds_ram_stream(const uint32_t* words, uint16_t count);
+
+    // Special registers functions (ad9910_register_helpers.cpp)
+    dds_status_t dds_cfr1_defaults();       // ✅🤔
+    dds_status_t dds_cfr1_drg_setup();      // ✅🤔
+    dds_status_t dds_cfr1_drg_basic();      // ✅🤔
+    dds_status_t dds_cfr2_defaults();       // ✅🤔
+    dds_status_t dds_cfr2_drg_freq_enable(bool continuous);
+    dds_status_t dds_cfr3_defaults( bool ref_div2,
+                                    bool pll_enable,
+                                    uint8_t pll_mult,
+                                    ad9910_reg::CFR3::VcoSel vco_sel = ad9910_reg::CFR3::VcoSel::VCO5,   // GRA & AFCH default
+                                    ad9910_reg::CFR3::IcpCode icp    = ad9910_reg::CFR3::IcpCode::u387); // GRA & AFCH default
+    dds_status_t dds_aux_dac_fsc(bool high_current);                        // NEW (FSC)
+    dds_status_t dds_drg_set_limit(uint32_t lower, uint32_t upper);
+    dds_status_t dds_drg_set_step(uint32_t incr, uint32_t decr);
+    dds_status_t dds_drg_set_rate(uint16_t pos, uint16_t neg);
+    dds_status_t dds_drg_program_range( uint32_t ftw_start,
+                                        uint32_t ftw_end,
+                                        uint32_t ftw_step,
+                                        uint16_t step_rate);
+    void dds_drg_batch_range(   RegisterBatch& batch,               // DR_LIMIT + DR_STEP + DR_RATE
+                                uint32_t ftw_start,
+                                uint32_t ftw_end,
+                                uint32_t ftw_step,
+                                uint16_t step_rate);
+    void dds_drg_batch_range(   RegisterBatch& batch,               // same, separate up / down slopes
+                                uint32_t ftw_lower,
+                                uint32_t ftw_upper,
+                                uint32_t step_up,
+                                uint32_t step_down,
+                                uint16_t rate_up,
+                                uint16_t rate_down);
     dds_status_t dds_update_io_pulse(); // ✅🤔
-    dds_status_t dds_program_aux_dac();     // NEW (FSC)
 
     // --- AD9910-specifics : Sequences ---
     static constexpr std::array<DdsSequence, 19> seq_setup_ = {{
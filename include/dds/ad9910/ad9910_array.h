@@ -0,0 +1,81 @@
+#pragma once
+#include "core_types.h"
+#include "ad9910.h"
+#include <vector>
+
+// ----------------------------------------
+//              AD9910 ARRAY
+// ----------------------------------------
+// N AD9910s behind one MCU for phase-coherent channels: SCLK / SDIO shared, one CS each,
+// every other control line (IO_UPDATE, MASTER_RESET, PROFILE, ...) wired to all chips and
+// REFCLK from one source. The array owns the drivers; channel i is an ordinary AD9910 on
+// cs_pins[i] for anything channel-specific.
+//
+// init() brings the channels up together: every CS high, one reset on the shared lines, the
+// set-up registers sent once with all CS low and latched by a single IO_UPDATE. sync()
+// aligns the chips' clock generators (MULTICHIP_SYNC, channel 0 drives SYNC_OUT into every
+// SYNC_IN) and restarts all phase accumulators on the same edge. After that, writes staged
+// per channel (io_update = false) become active together on io_update().
+//
+//   const pin_t cs[4] = { make_pin(PORT_A, 0, PIN_OUTPUT), ... };
+//   DdsArray arr(board, spi_cfg, ctx, cs, 4);
+//   arr.init();
+//   arr.sync();
+//   for (uint8_t i = 0; i < 4; ++i) arr[i].dds_profile_load(0, ftw, pow[i], asf, false);
+//   arr.io_update();
+class DdsArray {
+public:
+    static constexpr uint8_t MAX_CHANNELS = 8;
+
+    // n = 0 or > MAX_CHANNELS leaves the array empty (init() → DDS_INVALID_PARAM)
+    DdsArray(HWAbstraction& hw,
+             const HWAbstraction::spi_config_t& spi_cfg,
+             const AD9910Context& ctx,                              // same REFCLK / PLL everywhere
+             const pin_t* cs_pins,
+             uint8_t n,
+             const std::array<pin_t, kPinCount>& shared = dds_pins());   // all but SPI_CS
+    DdsArray(const DdsArray&)            = delete;
+    DdsArray& operator=(const DdsArray&) = delete;
+
+    dds_status_t init();
+
+    // gen_delay: channel 0's SYNC_OUT delay; rx_delay: one per channel (board skew), nullptr = 0
+    dds_status_t sync(uint8_t gen_delay = 0, const uint8_t* rx_delay = nullptr, uint8_t preset = 0);
+
+    // Same frames to every channel, staged until io_update(). Frames every channel already
+    // holds are dropped. With port access the CS lines are pulled low together (one masked
+    // port write per port they sit on) and the frames are clocked once; CFR2 then goes out as
+    // given, no internal I/O update overlay. Without port access each channel gets its own
+    // dds_reg_flush in turn. The batch is cleared.
+    dds_status_t broadcast(RegisterBatch& batch);
+    template<typename R>
+    dds_status_t broadcast(typename R::value_type v) {
+        RegisterBatch b;
+        b.add<R>(v);
+        return broadcast(b);
+    }
+
+    dds_status_t io_update();                                   // one edge on the shared line
+
+    uint8_t       size() const                  { return static_cast<uint8_t>(chips_.size()); }
+    AD9910&       operator[](uint8_t i)         { return chips_[i]; }
+    const AD9910& operator[](uint8_t i) const   { return chips_[i]; }
+
+private:
+    std::vector<std::array<pin_t, kPinCount>> pins_;            // reserved up front: drivers keep pointers
+    std::vector<AD9910>                       chips_;
+
+    // CS lines grouped by board port (init). cs_port_count_ == 0 → the board has no port
+    // access, broadcast() falls back to one transfer per channel.
+    struct cs_port_t {
+        uint8_t  port;
+        uint32_t mask;              // every channel's CS bit on this port
+    };
+    cs_port_t cs_ports_[MAX_CHANNELS] = {};
+    uint8_t   cs_port_count_ = 0;
+
+    void         group_cs_ports();
+    dds_status_t select_all(bool selected);                     // one masked write per port, first error kept
+    dds_status_t broadcast_each(RegisterBatch& batch);
+    dds_status_t phase_restart();
+};
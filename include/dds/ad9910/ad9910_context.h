@@ -8,6 +8,8 @@ struct AD9910Context{
     uint16_t pll_mult           ;    
     bool     dac_high_current   ;   // false -> 0x7F (normal), true -> 0xFF (high current)
     bool     allow_overclock    ;   // false = limit SYSCLK to 1.0 GHz, true = allow up to ~1.52 GHz
+    uint16_t io_update_pulse_us = 10;   // IO_UPDATE high time, 0 = two back-to-back pin writes
+                                        // (datasheet: > 1 SYNC_CLK = 4 SYSCLK, ~4 ns at 1 GHz)
 
 };
 
@@ -18,4 +20,5 @@ struct AD9910Context{
 // ctx.pll_enable      = true;
 // ctx.pll_mult        = 20;
 // ctx.dac_high_current= true;
-// ctx.allow_overclock = true;  
\ No newline at end of file
+// ctx.allow_overclock = true;
+// ctx.io_update_pulse_us = 10;  
\ No newline at end of file
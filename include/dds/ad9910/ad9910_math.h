@@ -0,0 +1,121 @@
+#pragma once
+#include "core_types.h"
+
+// Flash-resident tables: PROGMEM + pgm_read on AVR, plain const arrays elsewhere
+#if defined(__AVR__)
+    #include <avr/pgmspace.h>
+    #define AD9910_PROGMEM              PROGMEM
+    #define AD9910_PGM_READ_U32(p)      pgm_read_dword(p)
+#else
+    #define AD9910_PROGMEM
+    #define AD9910_PGM_READ_U32(p)      (*(p))
+#endif
+
+// ----------------------------------------
+//           AD9910 INTEGER MATH
+// ----------------------------------------
+// FTW, DRG step/rate and ASF with 64-bit integer and Q-format arithmetic only: no float,
+// double or long double, so nothing pulls soft-float into the AVR build. Results match the
+// previous floating point versions bit for bit, except where those were wrong: best_step_rate
+// where double's ceil() overshot an exact integer, and saturation instead of wrap-around
+// when the DRG multiplier overflowed (✅ TESTED : test > test_math).
+namespace ad9910_math {
+
+    // ---- 128-bit helpers (AVR has no __int128) ----
+    struct u128_t { uint64_t hi; uint64_t lo; };
+
+    u128_t   mul_u64(uint64_t a, uint64_t b);
+    bool     less(u128_t a, u128_t b);
+    // Floor n / d (d ≠ 0). Saturates to UINT64_MAX when the quotient doesn't fit.
+    uint64_t div_u128(u128_t n, uint64_t d, uint64_t* rem = nullptr);
+    // Round-half-up n / d, same saturation
+    uint64_t div_round_u128(u128_t n, uint64_t d);
+
+    // ---- Frequency ----
+    // round(freq_hz × 2^32 / sysclk_hz), 0xFFFFFFFF when freq ≥ sysclk, 0 for 0 inputs
+    uint32_t ftw_from_hz(uint32_t freq_hz, uint32_t sysclk_hz);
+
+    // Same result without the 64-bit division: FTW = (f × R + 2^(k-1)) >> k with
+    // R = ceil(2^(32+k) / sysclk) and 2^k ≥ 2·sysclk². Then f·R / 2^k = f·2^32/sysclk + δ,
+    // 0 ≤ δ < f / 2^k < 1 / (2·sysclk), smaller than the distance from any
+    // f·2^32/sysclk + 1/2 (a multiple of 1/(2·sysclk)) to the next integer: the rounding
+    // is exactly the division's. Needs sysclk < 2^30 (R fits 64 bits), r == 0 otherwise.
+    struct ftw_recip_t {
+        uint64_t r;         // R, 0 = not usable (fall back to the division)
+        uint8_t  shift;     // k
+        uint32_t sysclk_hz;
+    };
+
+    ftw_recip_t ftw_recip(uint32_t sysclk_hz);                           // once per sysclk
+    uint32_t    ftw_from_hz(uint32_t freq_hz, const ftw_recip_t& rc);    // 2 × 32×32 multiplies
+    void        ftw_from_hz_batch(const uint32_t* freq_hz, uint32_t* ftw_out,
+                                  size_t n, const ftw_recip_t& rc);
+
+    // Vector kernels for the batch (ad9910_math_simd.cpp): AVX2 (picked at run time),
+    // SSE2 or NEON when the target has them. Converts a prefix of the list and returns
+    // its length; the caller finishes with the scalar path. 0 on AVR / without SIMD.
+    size_t      ftw_batch_simd(const uint32_t* freq_hz, uint32_t* ftw_out,
+                               size_t n, const ftw_recip_t& rc);
+    const char* ftw_batch_kernel();                 // "avx2", "sse2", "neon" or "scalar"
+
+    // ---- Amplitude ----
+    // floor(10^((dB + 84.288) / 20)) clamped to 14 bits: 0 at ≤ -84.29 dB, 0x3FFF at ≥ 0 dB
+    uint16_t asf_from_cdb(int32_t centi_db);        // 0.01 dB steps
+    uint16_t asf_from_db(int16_t db);               // = asf_from_cdb(100 × db)
+
+    // ---- Phase ----
+    // round(cdeg × 65536 / 36000), 0..360° → 0..0xFFFF (360° itself clamps to the last step)
+    uint16_t pow_from_cdeg(uint32_t centi_deg);
+
+    // ---- Digital ramp ----
+    // DRG step (FTW units) and rate (SYSCLK/4 ticks) so that delta_ftw is covered in ~desired_ns.
+    // The ramp lasts 4 × delta / step × rate / sysclk; one of step / rate stays at 1.
+    bool drg_step_rate(uint32_t delta_ftw, uint64_t desired_ns, uint64_t sysclk_hz,
+                       uint32_t& ftw_step, uint16_t& step_rate);
+
+    // Closest DRG ramp to a duration in DRG ticks (4 SYSCLK periods). The chip takes
+    // ceil(delta / step) steps of rate ticks each (the last step clamps at the limit), so the
+    // search runs over exact tick counts: small rates with the step following, small steps
+    // with the rate following. Never worse than drg_step_rate. Returns the achieved ticks.
+    uint64_t drg_fit(uint32_t delta_ftw, uint64_t ticks, uint32_t& ftw_step, uint16_t& step_rate);
+
+    // Optimal DRG ramp: the (step, rate) pair whose exact duration ceil(delta / step) × rate
+    // is closest to ticks over the whole space (step 1..delta, steps above delta behave like
+    // delta; rate 1..65535). Step counts n = ceil(delta / step) take every integer up to
+    // √delta and only ~√delta distinct values above it, so the search is exhaustive in
+    // ≤ 2·√delta + 65535 candidates: each sparse n with its best rate, then each rate with
+    // its best dense n. Stops at the first exact hit. Tens of thousands of 64-bit divisions
+    // for wide sweeps (seconds on AVR), so the driver uses drg_fit: this one is for host tools
+    // or an offline table, e.g. to check how far drg_fit is from the optimum.
+    struct drg_solution_t {
+        uint32_t ftw_step;
+        uint16_t step_rate;
+        uint32_t steps;             // ceil(delta / ftw_step)
+        uint64_t ticks;             // steps × step_rate, what the chip runs
+        uint32_t last_step;         // FTW covered by the final step (clamped at the limit)
+    };
+    bool drg_solve(uint32_t delta_ftw, uint64_t ticks, drg_solution_t& out);
+
+    // Auto OSK ramp 0 → asf in ~ticks (4 SYSCLK each): ceil(asf / 2^code) steps of rate ticks.
+    // step_code 0..3 is kept, anything else picks the code with the closest time (smallest
+    // step on a tie). Returns the achieved ticks, 0 for asf == 0.
+    uint64_t osk_fit(uint16_t asf, uint64_t ticks, uint8_t& step_code, uint16_t& rate);
+
+    // Internal I/O update period in f_SYSCLK / 4 ticks (drg_ticks_from_ns) → prescaler code a
+    // (÷ 2^a) and counter b ≥ 4, smallest a that fits. Returns the achieved ticks, 0 when
+    // shorter than 4 ticks or longer than 8 × 0xFFFFFFFF.
+    uint64_t io_update_fit(uint64_t ticks, uint8_t& a, uint32_t& b);
+
+    // Parallel port FM: smallest gain (0..15) with span_ftw ≤ 0xFFFF << gain, i.e. the finest
+    // resolution that still reaches span_ftw above the FTW register. 15 if nothing fits.
+    uint8_t par_fm_gain(uint32_t span_ftw);
+
+    // ns ↔ DRG ticks, rounded to nearest
+    uint64_t drg_ticks_from_ns(uint64_t ns, uint64_t sysclk_hz);
+    uint64_t drg_ns_from_ticks(uint64_t ticks, uint64_t sysclk_hz);
+
+    // Step rate for step FTW increments at f_mod_hz: rate = ceil(sysclk / (4 × f_mod × step)),
+    // then step = min(sysclk / (4 × rate × f_mod), 65535)
+    bool best_step_rate(uint64_t sysclk_hz, uint32_t f_mod_hz, uint16_t& step, uint64_t& step_rate);
+
+} // namespace ad9910_math
@@ -66,9 +66,10 @@ constexpr std::array<pin_t, kPinCount> make_dds_pins_mega() {
 // =================== Create the PinMap For Mega ===================
 // =================== -------------------------- ===================
 
+inline constexpr std::array<pin_t, kPinCount> kDdsPinsMega = make_dds_pins_mega();
+
 constexpr const std::array<pin_t, kPinCount>& dds_pins() {
-    static constexpr auto pins = make_dds_pins_mega();
-    return pins;
+    return kDdsPinsMega;
 }
 
 // =================== -------------------------- ===================
@@ -79,4 +80,10 @@ static_assert(dds_pins().size() == kPinCount, "DdsPin enum and table out of sync
 constexpr const pin_t& pin(DdsPin id) {
     return dds_pins()[idx(id)];}
 
+// Same map with another SPI_CS: one chip per CS on a shared bus (DdsArray)
+constexpr std::array<pin_t, kPinCount> dds_pins_with_cs(const std::array<pin_t, kPinCount>& base, const pin_t& cs) {
+    std::array<pin_t, kPinCount> a = base;
+    a[idx(DdsPin::SPI_CS)] = cs;
+    return a;}
+
 
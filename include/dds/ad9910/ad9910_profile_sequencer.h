@@ -0,0 +1,104 @@
+#pragma once
+#include "core_types.h"
+#include "ad9910.h"
+#include "dds/dds_ring.h"
+
+// ----------------------------------------
+//         AD9910 PROFILE SEQUENCER
+// ----------------------------------------
+// Buffered frequency list played back on external triggers (OG: outputBufferedFrequencies).
+//
+// The list is converted to FTW/POW/ASF once (prepare). start() preloads the first eight
+// entries into PROFILE0..7; entry i always lives in slot i % 8. A trigger only moves the
+// PROFILE pins to the next slot, no SPI and no IO_UPDATE on that path. service() refills
+// the slots the output has already left, one per call, from the main loop.
+//
+//   ProfileSequencer::entry_t list[N];
+//   ProfileSequencer::prepare(dds, freqs, N, 0, list);
+//   seq.start(list, N);
+//   for (;;) { if (trigger_seen()) seq.trigger(); seq.service(); }
+//
+// trigger() and service() must run in the same context (same as the OG polling loop).
+//
+// Streaming: instead of a list that must fit in RAM, start(stream, n) pulls entries from an
+// SpscRing of ready-to-clock PROFILE payloads, filled from the host's CMD_ENTRY_LIST frames
+// while the shot runs. Only the ring (64 × 8 bytes) lives on the board, so n is not bounded
+// by RAM. A frame that doesn't fit is NAKed whole and counted in overruns(); the host sends
+// it again after the next ACK.
+//
+//   loop:  while (link.poll()) {
+//              const auto& f = link.frame();
+//              link.reply(f.cmd(), ProfileSequencer::stream_entries(stream, f.payload(), f.len(), &next));
+//          }
+//          seq.start(stream, N) once data is in, then trigger() / service() as above
+class ProfileSequencer {
+public:
+    static constexpr uint8_t SLOTS = 8;
+
+    struct entry_t {
+        uint32_t ftw;
+        uint16_t pow;
+        uint16_t asf;
+    };
+
+    // PROFILEn payload as clocked out (PROFILE0::bytes): no conversion left on the consumer side
+    struct frame_t {
+        uint8_t bytes[ad9910_reg::PROFILE0::length];
+    };
+
+    static constexpr uint8_t STREAM_DEPTH = 64;
+    using stream_t = SpscRing<frame_t, STREAM_DEPTH>;
+
+    explicit ProfileSequencer(AD9910& dds) : dds_(dds) {}
+
+    static frame_t frame(uint32_t ftw, uint16_t pow, uint16_t asf);
+
+    // CMD_ENTRY_LIST payload → stream, converted to frames. The offset must be *next mod 2^16
+    // (entries arrive in order, *next advances by the count taken). DDS_INVALID_PARAM for a malformed
+    // payload or an out-of-order offset, DDS_TIMEOUT when the ring lacks room for all of them:
+    // nothing is pushed then and overruns() counts it.
+    static dds_status_t stream_entries(stream_t& stream, const uint8_t* payload, uint8_t len, size_t* next);
+
+    // Frequencies (Hz) at one amplitude → out[0..n)
+    static void prepare(const AD9910& dds,
+                        const uint32_t* freqs_hz,
+                        size_t n,
+                        int16_t ampl_db,
+                        entry_t* out);
+
+    // Preloads up to 8 entries, one IO_UPDATE, outputs entry 0. list must outlive the run.
+    dds_status_t start(const entry_t* list, size_t n);
+
+    // n entries taken from stream in order. Preloads what the ring already holds (up to 8),
+    // DDS_TIMEOUT if it is still empty. service() keeps pulling; a trigger that overtakes
+    // the producer counts as an underrun like in list mode.
+    dds_status_t start(stream_t& stream, size_t n);
+
+    // Next entry: PROFILE pins only. DDS_TIMEOUT if service() hasn't loaded it yet (underrun,
+    // output stays on the current entry). After the last entry the output holds and done() is true.
+    dds_status_t trigger();
+
+    // Writes one idle slot if any is due. Returns true while refills remain.
+    bool service();
+
+    void stop() { list_ = nullptr; stream_ = nullptr; count_ = 0; }
+
+    bool     done()      const { return done_; }
+    size_t   position()  const { return pos_; }      // entry currently output
+    size_t   loaded()    const { return loaded_; }   // entries [0, loaded) written to the chip
+    uint32_t underruns() const { return underruns_; }
+
+private:
+    AD9910&         dds_;
+    const entry_t*  list_      = nullptr;
+    stream_t*       stream_    = nullptr;
+    size_t          count_     = 0;
+    size_t          pos_       = 0;
+    size_t          loaded_    = 0;
+    uint32_t        underruns_ = 0;
+    bool            done_      = false;
+
+    bool         running() const { return list_ || stream_; }
+    dds_status_t load(size_t i, bool io_update);
+    dds_status_t begin(size_t n, size_t first);
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstring>
+#include "core_types.h"
+#include "ad9910_registers.h"
+
+// ----------------------------------------
+//           AD9910 REGISTER BATCH
+// ----------------------------------------
+// Collects register writes as ready-to-send [instruction][payload] frames in one
+// contiguous buffer. The AD9910 serial port starts a new instruction cycle after each
+// register's last byte, so the whole buffer goes out under a single CS assertion with
+// one spi_tx (see AD9910::dds_reg_flush).
+//
+//   RegisterBatch b;
+//   b.add(ad9910_reg::fixed::CFR1_DEFAULTS);
+//   b.add<ad9910_reg::DR_RATE>(ad9910_reg::DR_RATE::set_rate(r, r));
+//   dds_reg_flush(b);
+class RegisterBatch {
+public:
+    static constexpr uint8_t MAX_FRAMES = 16;
+    static constexpr uint8_t MAX_BYTES  = 96;   // 8 profiles + DR_LIMIT/STEP need 90
+
+    struct entry_t {
+        uint8_t addr;       // serial address
+        uint8_t offset;     // instruction byte position in the buffer
+        uint8_t len;        // payload length
+    };
+
+    // Raw payload; len must be the register's length (RAM is not batched)
+    bool add(uint8_t addr, const uint8_t* payload, uint8_t len) {
+        if (!payload || len == 0 || len != ad9910_reg::reg_len(addr)) return fail();
+        if (count_ >= MAX_FRAMES || size_ + 1u + len > MAX_BYTES)     return fail();
+        entries_[count_++] = { addr, size_, len };
+        buf_[size_] = static_cast<uint8_t>(addr & 0x7Fu);
+        std::memcpy(&buf_[size_ + 1], payload, len);
+        size_ = static_cast<uint8_t>(size_ + 1u + len);
+        return true;
+    }
+
+    // Complete frame (instruction + payload)
+    bool add_frame(const uint8_t* frame, uint8_t len) {
+        if (!frame || len < 2) return fail();
+        return add(frame[0] & 0x7Fu, frame + 1, static_cast<uint8_t>(len - 1));
+    }
+
+    template<typename R>
+    bool add(const FixedReg<R>& fixed) {
+        return add_frame(fixed.frame.data(), static_cast<uint8_t>(fixed.frame.size()));
+    }
+
+    template<typename R>
+    bool add(typename R::value_type v) {
+        const auto f = R::frame(v);
+        return add_frame(f.data(), static_cast<uint8_t>(f.size()));
+    }
+
+    // Removes the frames for which skip(addr, payload, len) is true, keeping order
+    template<typename Pred>
+    void drop_if(Pred skip) {
+        uint8_t w_count = 0, w_size = 0;
+        for (uint8_t i = 0; i < count_; i++) {
+            const entry_t e = entries_[i];
+            if (skip(e.addr, &buf_[e.offset + 1], e.len)) continue;
+            if (w_size != e.offset) std::memmove(&buf_[w_size], &buf_[e.offset], 1u + e.len);
+            entries_[w_count++] = { e.addr, w_size, e.len };
+            w_size = static_cast<uint8_t>(w_size + 1u + e.len);
+        }
+        count_ = w_count;
+        size_  = w_size;
+    }
+
+    void clear() { count_ = 0; size_ = 0; overflow_ = false; }
+
+    uint8_t        count()    const { return count_; }
+    uint8_t        size()     const { return size_; }
+    bool           empty()    const { return count_ == 0; }
+    bool           overflow() const { return overflow_; }   // an add() was rejected
+    const uint8_t* data()     const { return buf_; }
+    const entry_t& entry(uint8_t i) const { return entries_[i]; }
+    const uint8_t* payload(uint8_t i) const { return &buf_[entries_[i].offset + 1]; }
+    uint8_t*       payload(uint8_t i)       { return &buf_[entries_[i].offset + 1]; }
+
+private:
+    bool fail() { overflow_ = true; return false; }
+
+    uint8_t  buf_[MAX_BYTES];
+    entry_t  entries_[MAX_FRAMES];
+    uint8_t  count_    = 0;
+    uint8_t  size_     = 0;
+    bool     overflow_ = false;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstring>
+#include "core_types.h"
+#include "ad9910_registers.h"
+
+// ----------------------------------------
+//           AD9910 REGISTER CACHE
+// ----------------------------------------
+// Byte image of what the chip's I/O buffers hold, one slot per serial address.
+// A slot is only valid after a complete, successful write of that register; the
+// whole cache is dropped on MASTER_RESET (the chip reverts to its defaults).
+// RAM (0x16) is a stream, not a register, and is never cached.
+class AD9910RegCache {
+public:
+    static constexpr uint8_t REG_MAX_LEN = 8;
+
+    bool valid(uint8_t addr) const {
+        return addr < ad9910_reg::REG_COUNT && (valid_mask_ & (uint32_t(1) << addr)) != 0;
+    }
+
+    // True when the chip already holds exactly these bytes at addr
+    bool matches(uint8_t addr, const uint8_t* data, size_t len) const {
+        if (!cacheable(addr, len) || !valid(addr)) return false;
+        return std::memcmp(bytes_[addr], data, len) == 0;
+    }
+
+    void store(uint8_t addr, const uint8_t* data, size_t len) {
+        if (!cacheable(addr, len)) return;
+        std::memcpy(bytes_[addr], data, len);
+        valid_mask_ |= (uint32_t(1) << addr);
+    }
+
+    void invalidate(uint8_t addr) {
+        if (addr < ad9910_reg::REG_COUNT) valid_mask_ &= ~(uint32_t(1) << addr);
+    }
+
+    void invalidate_all() { valid_mask_ = 0; }
+
+private:
+    static bool cacheable(uint8_t addr, size_t len) {
+        return addr != static_cast<uint8_t>(ad9910_reg::Reg::RAM) &&
+               len != 0 && len == ad9910_reg::reg_len(addr);
+    }
+
+    uint8_t  bytes_[ad9910_reg::REG_COUNT][REG_MAX_LEN] = {};
+    uint32_t valid_mask_ = 0;   // bit n ↔ address n holds known content
+};
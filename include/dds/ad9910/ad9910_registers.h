@@ -10,6 +10,7 @@
 // --- Single Tone Profile Helper --- 
 template<uint8_t Addr>
 struct PROFILE : Register<Addr, 8> {
+    using typename Register<Addr, 8>::value_type;
     static constexpr uint8_t index = Addr - 0x0E;
 
     using FTW1 = Field<0 , 8>;          // Frequency Tuning Word Byte 1 
@@ -21,24 +22,24 @@ struct PROFILE : Register<Addr, 8> {
     using ASF7 = Field<48, 8>;          // Amplitude Scale Factor Byte 7
     using ASF8 = Field<56, 6>;          // Amplitude Scale Factor Byte 8
 
-    static value_type single_tone(uint32_t ftw, uint16_t pow, uint16_t asf){
-        PROFILE::shadow.val = 0;
+    static constexpr value_type single_tone(uint32_t ftw, uint16_t pow, uint16_t asf){
+        value_type v{};
 
         // FTW (32-bit, LSB first)
-        PROFILE::write<FTW1>(static_cast<uint8_t>( ftw        & 0xFFu));
-        PROFILE::write<FTW2>(static_cast<uint8_t>((ftw >>  8) & 0xFFu));
-        PROFILE::write<FTW3>(static_cast<uint8_t>((ftw >> 16) & 0xFFu));
-        PROFILE::write<FTW4>(static_cast<uint8_t>((ftw >> 24) & 0xFFu));
+        v = PROFILE::template insert<FTW1>(static_cast<uint8_t>( ftw        & 0xFFu), v);
+        v = PROFILE::template insert<FTW2>(static_cast<uint8_t>((ftw >>  8) & 0xFFu), v);
+        v = PROFILE::template insert<FTW3>(static_cast<uint8_t>((ftw >> 16) & 0xFFu), v);
+        v = PROFILE::template insert<FTW4>(static_cast<uint8_t>((ftw >> 24) & 0xFFu), v);
 
         // POW (16-bit, LSB first)
-        PROFILE::write<POW5>(static_cast<uint8_t>( pow        & 0xFFu));
-        PROFILE::write<POW6>(static_cast<uint8_t>((pow >>  8) & 0xFFu));
+        v = PROFILE::template insert<POW5>(static_cast<uint8_t>( pow        & 0xFFu), v);
+        v = PROFILE::template insert<POW6>(static_cast<uint8_t>((pow >>  8) & 0xFFu), v);
 
         // ASF (14-bit)
-        uint16_t asf14 = asf & 0x3FFFu;  // enforce 14 bits
-        PROFILE::write<ASF7>(static_cast<uint8_t>( asf14        & 0xFFu));   // ASF[7:0]
-        PROFILE::write<ASF8>(static_cast<uint8_t>((asf14 >>  8) & 0x3Fu));   // ASF[13:8], 6 bits
-        return PROFILE::shadow;
+        const uint16_t asf14 = asf & 0x3FFFu;  // enforce 14 bits
+        v = PROFILE::template insert<ASF7>(static_cast<uint8_t>( asf14        & 0xFFu), v);   // ASF[7:0]
+        v = PROFILE::template insert<ASF8>(static_cast<uint8_t>((asf14 >>  8) & 0x3Fu), v);   // ASF[13:8], 6 bits
+        return v;
     }
 
 };
@@ -52,6 +53,42 @@ namespace ad9910_reg {
     // bit7 = 0 → write ;  bit7 = 1 → read
     constexpr uint8_t SPI_READ = 0x80;
 
+    // ---- Complete serial addresses ----
+    enum class Reg : uint8_t {
+        CFR1          = 0x00,
+        CFR2          = 0x01,
+        CFR3          = 0x02,
+        AUX_DAC       = 0x03,
+        IO_UPDATE_RATE= 0x04,
+        // 0x05, 0x06 reserved in datasheet register map
+        FTW           = 0x07,
+        POW           = 0x08,
+        ASF           = 0x09,
+        MULTICHIP_SYNC= 0x0A,
+        DR_LIMIT      = 0x0B,
+        DR_STEP       = 0x0C,
+        DR_RATE       = 0x0D,
+        PROFILE0      = 0x0E,
+        PROFILE1      = 0x0F,
+        PROFILE2      = 0x10,
+        PROFILE3      = 0x11,
+        PROFILE4      = 0x12,
+        PROFILE5      = 0x13,
+        PROFILE6      = 0x14,
+        PROFILE7      = 0x15,
+        RAM           = 0x16
+    };
+    constexpr uint8_t REG_COUNT = 0x17;     // 0x00 .. 0x16
+
+    // Payload length in bytes of every serial address (0 = reserved)
+    constexpr uint8_t reg_len(uint8_t addr) {
+        return  (addr == 0x08)                  ? 2 :   // POW
+                (addr == 0x05 || addr == 0x06)  ? 0 :   // reserved
+                (addr == 0x0B || addr == 0x0C)  ? 8 :   // DR_LIMIT, DR_STEP
+                (addr >= 0x0E && addr <= 0x15)  ? 8 :   // PROFILE0..7
+                (addr <  REG_COUNT)             ? 4 : 0;
+    }
+
     // ===== CFR1 (32-bit) =====
     struct CFR1 : Register<0x00, 4> {
 
@@ -77,25 +114,57 @@ namespace ad9910_reg {
         using SDIO_INPUT_ONLY   = Field<1>;     // [1] SDIO input-only
         using LSB_FIRST         = Field<0>;     // [0] LSB first
 
+        // RAM_DEST codes: the parameter RAM playback drives
+        enum class RamDest : uint8_t {
+            Frequency = 0x00,   // FTW
+            Phase     = 0x20,   // POW
+            Amplitude = 0x40,   // ASF
+            Polar     = 0x60    // POW + ASF
+        };
+
         // --- Helpers
-        static value_type defaults() {
-            CFR1::shadow.val = 0;
-            CFR1::set  <SDIO_INPUT_ONLY >(true);  // SDIO Input Only;   
-            return CFR1::shadow;}
-
-        static value_type drg_setup() {
-            CFR1::shadow.val = 0;
-            CFR1::set  <AUTOCLR_DRG_ACC >(true);
-            CFR1::set  <SDIO_INPUT_ONLY >(true);
-            return CFR1::shadow;}
-
-        static value_type drg_basic() {
-            CFR1::set  <RAM_ENABLE      >(false);
-            CFR1::insert<RAM_DEST        >(0u);
-            CFR1::set  <OSK_ENABLE      >(false);
-            CFR1::set  <AUTOCLR_DRG_ACC >(true);
-            CFR1::set  <SDIO_INPUT_ONLY >(true);
-            return CFR1::shadow;}
+        static constexpr value_type defaults() {
+            return set<SDIO_INPUT_ONLY>(true);}     // SDIO Input Only
+
+        static constexpr value_type drg_setup() {
+            value_type v{};
+            v = set<AUTOCLR_DRG_ACC >(true, v);
+            v = set<SDIO_INPUT_ONLY >(true, v);
+            return v;}
+
+        // Keeps every other bit of the current image v
+        static constexpr value_type drg_basic(value_type v) {
+            v = set   <RAM_ENABLE      >(false, v);
+            v = insert<RAM_DEST        >(0u,    v);
+            v = set   <OSK_ENABLE      >(false, v);
+            v = set   <AUTOCLR_DRG_ACC >(true,  v);
+            v = set   <SDIO_INPUT_ONLY >(true,  v);
+            return v;}
+
+        // RAM playback on, keeps every other bit of the current image v
+        static constexpr value_type ram_enable(RamDest dest, value_type v) {
+            v = set   <RAM_ENABLE      >(true, v);
+            v = insert<RAM_DEST        >(static_cast<uint8_t>(dest), v);
+            return v;}
+
+        // OSK on, keeps every other bit of the current image v. Automatic: the OSK pin ramps
+        // the amplitude between 0 and ASF. Manual: the pin switches between them at once.
+        static constexpr value_type osk_enable(bool automatic, value_type v) {
+            v = set   <OSK_ENABLE      >(true,       v);
+            v = set   <AUTO_OSK        >(automatic,  v);
+            v = set   <MANUAL_OSK      >(!automatic, v);
+            return v;}
+
+        static constexpr value_type osk_disable(value_type v) {
+            v = set   <OSK_ENABLE      >(false, v);
+            v = set   <AUTO_OSK        >(false, v);
+            v = set   <MANUAL_OSK      >(false, v);
+            return v;}
+
+        static constexpr value_type ram_disable(value_type v) {
+            v = set   <RAM_ENABLE      >(false, v);
+            v = insert<RAM_DEST        >(0u,    v);
+            return v;}
 
     };
 
@@ -121,19 +190,59 @@ namespace ad9910_reg {
         using FM_GAIN             = Field<0,4>;     // [3:0] FM gain
 
         // --- Helpers
-        static value_type defaults() {
-            CFR2::shadow.val = 0;     
-            CFR2::set<AMP_SCALE_PROFILE>(true);     // Enable_amplitude_scale_from_single_tone_profiles
-            CFR2::set<SYNC_VAL_DISABLE >(true);     // Sync_timing_validation_disable
-            return CFR2::shadow;}
-
-        static value_type drg_freq_enable(bool continuous) {
-            CFR2::shadow.val = 0;         
-            CFR2::set  <DR_ENABLE        >(true);
-            // CFR2::write<DR_DEST>(0u); // Freq destination (Already set becuase of shadow.val = 0)
-            CFR2::set  <DR_NODWELL_HIGH  >(continuous);
-            CFR2::set  <DR_NODWELL_LOW   >(continuous);
-            return CFR2::shadow;}
+        static constexpr value_type defaults() {
+            value_type v{};
+            v = set<AMP_SCALE_PROFILE>(true, v);    // Enable_amplitude_scale_from_single_tone_profiles
+            v = set<SYNC_VAL_DISABLE >(true, v);    // Sync_timing_validation_disable
+            return v;}
+
+        // DR_DEST codes: what the 32-bit ramp accumulator drives, MSB aligned
+        enum class DrgDest : uint8_t {
+            Frequency = 0x00,   // FTW, all 32 bits
+            Phase     = 0x10,   // POW, accumulator [31:16]
+            Amplitude = 0x20    // ASF, accumulator [31:18]
+        };
+        static constexpr uint8_t drg_shift(DrgDest d) {
+            return d == DrgDest::Phase ? 16u : d == DrgDest::Amplitude ? 18u : 0u;}
+
+        // No-dwell high: at the upper limit the output snaps back to the lower one.
+        // No-dwell low: same at the lower limit. Both: free-running triangle.
+        static constexpr value_type drg_enable(DrgDest dest, bool nodwell_high, bool nodwell_low) {
+            value_type v{};
+            v = set   <DR_ENABLE        >(true, v);
+            v = insert<DR_DEST          >(static_cast<uint8_t>(dest), v);
+            v = set   <DR_NODWELL_HIGH  >(nodwell_high, v);
+            v = set   <DR_NODWELL_LOW   >(nodwell_low,  v);
+            return v;}
+
+        static constexpr value_type drg_freq(bool nodwell_high, bool nodwell_low) {
+            return drg_enable(DrgDest::Frequency, nodwell_high, nodwell_low);}
+
+        static constexpr value_type drg_freq_enable(bool continuous) {
+            return drg_freq(continuous, continuous);}
+
+        // Internal I/O update on / off with prescaler code A (÷ 1, 2, 4, 8), keeps every other
+        // bit of the current image v. On: the IO_UPDATE pin becomes a chip output.
+        static constexpr value_type io_update_internal(bool on, uint8_t a, value_type v) {
+            v = set   <INT_IO_UPDATE       >(on, v);
+            v = insert<IO_UPDATE_RATE_CTRL >(static_cast<uint8_t>((on ? a & 0x03u : 0u) << 6), v);
+            return v;}
+
+        // Parallel data port with PDCLK output, DRG off; every other bit of v kept.
+        // hold_last: the data assembler keeps the last word while TxEnable is low (else 0).
+        static constexpr value_type parallel_enable(uint8_t fm_gain, bool hold_last, value_type v) {
+            v = set   <DR_ENABLE        >(false,     v);
+            v = set   <PAR_DATA_ENABLE  >(true,      v);
+            v = set   <PDCLK_ENABLE     >(true,      v);
+            v = set   <HOLD_LAST_VALUE  >(hold_last, v);
+            v = insert<FM_GAIN          >(static_cast<uint8_t>(fm_gain & 0x0Fu), v);
+            return v;}
+
+        static constexpr value_type parallel_disable(value_type v) {
+            v = set   <PAR_DATA_ENABLE  >(false, v);
+            v = set   <PDCLK_ENABLE     >(false, v);
+            v = insert<FM_GAIN          >(0u,    v);
+            return v;}
     };
 
     // ===== CFR3 (32-bit) =====
@@ -158,8 +267,8 @@ namespace ad9910_reg {
             u337 = 0x28,  // 337 µA
             u363 = 0x30,  // 363 µA
             u387 = 0x38   // 387 µA
-        }
-        static void set_icp(IcpCode icp) { write<ICP>(static_cast<uint8_t>(icp));}
+        };
+        static constexpr value_type set_icp(IcpCode icp, value_type v) { return insert<ICP>(static_cast<uint8_t>(icp), v);}
         
         // --- VCO SETTINGS
         enum class VcoSel : uint8_t {
@@ -171,26 +280,31 @@ namespace ad9910_reg {
             VCO5 = 5,  // 820–1150 MHz
             Invalid = 0xFF
         };
-        static void set_vco(VcoSel vco_sel){ write<VCO_SEL_FIELD>(static_cast<uint8_t>(vco_sel));}
+        static constexpr value_type set_vco(VcoSel vco_sel, value_type v){ return insert<VCO_SEL>(static_cast<uint8_t>(vco_sel), v);}
 
         // --- Helpers
-        static value_type default_pll_off(bool ref_div2) {
-            CFR3::shadow.val = 0;     
-            CFR3::set<REF_DIV_RESETB>(true);         // REFCLK divider reset always = 1
-            CFR3::set<REF_DIV_BYPASS>(!ref_div2);    // REFCLK divider bypass       = !ref_div2
-            return CFR3::shadow;}                   
+        static constexpr value_type default_pll_off(bool ref_div2) {
+            value_type v{};
+            v = set<REF_DIV_RESETB>(true, v);        // REFCLK divider reset always = 1
+            v = set<REF_DIV_BYPASS>(!ref_div2, v);   // REFCLK divider bypass       = !ref_div2
+            return v;}
         
-        static value_type default_pll_on(   bool ref_div2       ,
-                                            uint8_t pll_mult    ,
-                                            VcoSel vco_sel      , 
-                                            IcpCode icp ) {
-            CFR3::shadow.val = 0; 
-            CFR3::set<REF_DIV_RESETB>(true);        // REFCLK divider reset always = 1
-            CFR3::set<PLL_ENABLE>(true);            // Enable PLL
-            set_icp(icp);                           // Set max charge pump current
-            set_vco(vco_sel);                       // Set VCO range
-            CFR3::write<NPLL>(pll_mult);            // Set PLL multiplier N
-            return CFR3::shadow;}
+        static constexpr value_type default_pll_on( bool ref_div2       ,
+                                                    uint8_t pll_mult    ,
+                                                    VcoSel vco_sel      , 
+                                                    IcpCode icp ) {
+            value_type v{};
+            v = set<REF_DIV_RESETB>(true, v);       // REFCLK divider reset always = 1
+            v = set<PLL_ENABLE>(true, v);           // Enable PLL
+            v = set_icp(icp, v);                    // Set max charge pump current
+            v = set_vco(vco_sel, v);                // Set VCO range
+            v = insert<NPLL>(pll_mult, v);          // Set PLL multiplier N
+            return v;}
+
+        static constexpr value_type defaults(   bool ref_div2, bool pll_enable, uint8_t pll_mult,
+                                                VcoSel vco_sel, IcpCode icp) {
+            return pll_enable ? default_pll_on(ref_div2, pll_mult, vco_sel, icp)
+                              : default_pll_off(ref_div2);}
     };
 
     // ===== Aux DAC (FSC), 32-bit, only low byte used =====
@@ -198,14 +312,19 @@ namespace ad9910_reg {
         using FSC = Field<0,8>;     // [7:0] full-scale current control
 
         // --- Helpers
-        static value_type defaults(bool current_high){
-            AUX_DAC::shadow.val = 0;
-            AUX_DAC::insert<FSC>(current_high ? 0xFFu : 0x7Fu);
-            return AUX_DAC::shadow;
+        static constexpr value_type defaults(bool current_high){
+            return insert<FSC>(current_high ? 0xFFu : 0x7Fu);
         }
 
     };
 
+    // ===== I/O update rate (32-bit) =====
+    // Internal I/O update period: 4 × 2^A × B / f_SYSCLK, A = CFR2[15:14], B ≥ 4 (≤ 3 holds
+    // the IO_UPDATE output high). Effective without an I/O update.
+    struct IO_UPDATE_RATE : Register<0x04, 4> {
+        static constexpr value_type set_rate(uint32_t b) { return value_type(b); }
+    };
+
     // ===== FTW (32-bit) =====
     struct FTW : Register<0x07, 4> {
 
@@ -235,14 +354,41 @@ namespace ad9910_reg {
         using SCALE_MSB     = Field<8,8>;       // [15:8]
         using SCALE_LSB     = Field<2,6>;       // [7:2]
         using STEP_SIZE     = Field<0,2>;       // [1:0] amplitude step size
+
+        // Auto OSK: every ramp_rate × 4 SYSCLK the amplitude moves by 1 << step_code LSBs
+        // (code 0..3) towards asf (OSK pin high) or 0 (low)
+        static constexpr value_type osk(uint16_t ramp_rate, uint16_t asf, uint8_t step_code) {
+            const uint16_t a = asf & 0x3FFFu;
+            value_type v{};
+            v = insert<RAMP_RATE_MSB>(static_cast<uint8_t>(ramp_rate >> 8),          v);
+            v = insert<RAMP_RATE_LSB>(static_cast<uint8_t>(ramp_rate & 0xFFu),       v);
+            v = insert<SCALE_MSB    >(static_cast<uint8_t>(a >> 6),                  v);
+            v = insert<SCALE_LSB    >(static_cast<uint8_t>((a & 0x3Fu) << 2),        v);
+            v = insert<STEP_SIZE    >(static_cast<uint8_t>(step_code & 0x03u),       v);
+            return v;}
     };
 
     // ===== Multichip Sync (32-bit) =====
     struct MULTICHIP_SYNC : Register<0x0A, 4> {
 
-        using SYNC_RX_EN = Field<27>;
-        using SYNC_TX_EN = Field<26>;
-        using SYNC_TX_POL= Field<25>;
+        using SYNC_VALID_DELAY = Field<28,4>;   // [31:28] sync validation delay
+        using SYNC_RX_EN       = Field<27>;
+        using SYNC_TX_EN       = Field<26>;
+        using SYNC_TX_POL      = Field<25>;
+        using SYNC_STATE_PRESET= Field<18,6>;   // [23:18] clock generator state after sync
+        using SYNC_GEN_DELAY   = Field<11,5>;   // [15:11] output sync generator delay (~75 ps steps)
+        using SYNC_RX_DELAY    = Field<3,5>;    // [7:3]   input sync receiver delay (~75 ps steps)
+
+        // Receiver on every chip; the generator (SYNC_OUT) on the one that drives the others.
+        // Delays trim board skew, the preset should match across the array.
+        static constexpr value_type sync(bool generator, uint8_t gen_delay, uint8_t rx_delay, uint8_t preset) {
+            value_type v{};
+            v = set   <SYNC_RX_EN       >(true,      v);
+            v = set   <SYNC_TX_EN       >(generator, v);
+            v = insert<SYNC_STATE_PRESET>(static_cast<uint8_t>((preset    & 0x3Fu) << 2), v);
+            v = insert<SYNC_GEN_DELAY   >(static_cast<uint8_t>(generator ? (gen_delay & 0x1Fu) << 3 : 0u), v);
+            v = insert<SYNC_RX_DELAY    >(static_cast<uint8_t>((rx_delay  & 0x1Fu) << 3), v);
+            return v;}
     };
 
 
@@ -259,20 +405,20 @@ namespace ad9910_reg {
         using UPPER3 = Field<48, 8>;   // bits 55:48
         using UPPER4 = Field<56, 8>;   // bits 63:56
 
-        static value_type set_limit(uint32_t lower, uint32_t upper) {
-            shadow.val = 0;
+        static constexpr value_type set_limit(uint32_t lower, uint32_t upper) {
+            value_type v{};
             // LOWER (LSB first)
-            write<LOWER1>(static_cast<uint8_t>( lower        & 0xFFu));
-            write<LOWER2>(static_cast<uint8_t>((lower >>  8) & 0xFFu));
-            write<LOWER3>(static_cast<uint8_t>((lower >> 16) & 0xFFu));
-            write<LOWER4>(static_cast<uint8_t>((lower >> 24) & 0xFFu));
+            v = insert<LOWER1>(static_cast<uint8_t>( lower        & 0xFFu), v);
+            v = insert<LOWER2>(static_cast<uint8_t>((lower >>  8) & 0xFFu), v);
+            v = insert<LOWER3>(static_cast<uint8_t>((lower >> 16) & 0xFFu), v);
+            v = insert<LOWER4>(static_cast<uint8_t>((lower >> 24) & 0xFFu), v);
             // UPPER (LSB first within the upper half)
-            write<UPPER1>(static_cast<uint8_t>( upper        & 0xFFu));
-            write<UPPER2>(static_cast<uint8_t>((upper >>  8) & 0xFFu));
-            write<UPPER3>(static_cast<uint8_t>((upper >> 16) & 0xFFu));
-            write<UPPER4>(static_cast<uint8_t>((upper >> 24) & 0xFFu));
+            v = insert<UPPER1>(static_cast<uint8_t>( upper        & 0xFFu), v);
+            v = insert<UPPER2>(static_cast<uint8_t>((upper >>  8) & 0xFFu), v);
+            v = insert<UPPER3>(static_cast<uint8_t>((upper >> 16) & 0xFFu), v);
+            v = insert<UPPER4>(static_cast<uint8_t>((upper >> 24) & 0xFFu), v);
 
-            return shadow;
+            return v;
         }
     };
 
@@ -289,20 +435,20 @@ namespace ad9910_reg {
         using DEC3 = Field<48, 8>;   // bits 55:48
         using DEC4 = Field<56, 8>;   // bits 63:56
 
-        static value_type set_step(uint32_t inc, uint32_t dec) {
-            shadow.val = 0;
+        static constexpr value_type set_step(uint32_t inc, uint32_t dec) {
+            value_type v{};
             // Increment step size (LSB first)
-            write<INC1>(static_cast<uint8_t>( inc        & 0xFFu));
-            write<INC2>(static_cast<uint8_t>((inc >>  8) & 0xFFu));
-            write<INC3>(static_cast<uint8_t>((inc >> 16) & 0xFFu));
-            write<INC4>(static_cast<uint8_t>((inc >> 24) & 0xFFu));
+            v = insert<INC1>(static_cast<uint8_t>( inc        & 0xFFu), v);
+            v = insert<INC2>(static_cast<uint8_t>((inc >>  8) & 0xFFu), v);
+            v = insert<INC3>(static_cast<uint8_t>((inc >> 16) & 0xFFu), v);
+            v = insert<INC4>(static_cast<uint8_t>((inc >> 24) & 0xFFu), v);
             // Decrement step size (LSB first within upper 32 bits)
-            write<DEC1>(static_cast<uint8_t>( dec        & 0xFFu));
-            write<DEC2>(static_cast<uint8_t>((dec >>  8) & 0xFFu));
-            write<DEC3>(static_cast<uint8_t>((dec >> 16) & 0xFFu));
-            write<DEC4>(static_cast<uint8_t>((dec >> 24) & 0xFFu));
+            v = insert<DEC1>(static_cast<uint8_t>( dec        & 0xFFu), v);
+            v = insert<DEC2>(static_cast<uint8_t>((dec >>  8) & 0xFFu), v);
+            v = insert<DEC3>(static_cast<uint8_t>((dec >> 16) & 0xFFu), v);
+            v = insert<DEC4>(static_cast<uint8_t>((dec >> 24) & 0xFFu), v);
 
-            return shadow;
+            return v;
         }
     };
 
@@ -315,18 +461,93 @@ namespace ad9910_reg {
         using NEG1 = Field<16, 8>;   // bits 23:16
         using NEG2 = Field<24, 8>;   // bits 31:24
 
-        static value_type set_rate(uint16_t pos, uint16_t neg) {
-            shadow.val = 0;
+        static constexpr value_type set_rate(uint16_t pos, uint16_t neg) {
+            value_type v{};
             // positive slope
-            write<POS1>(static_cast<uint8_t>( pos        & 0xFFu));
-            write<POS2>(static_cast<uint8_t>((pos >>  8) & 0xFFu));
+            v = insert<POS1>(static_cast<uint8_t>( pos        & 0xFFu), v);
+            v = insert<POS2>(static_cast<uint8_t>((pos >>  8) & 0xFFu), v);
             // negative slope
-            write<NEG1>(static_cast<uint8_t>( neg        & 0xFFu));
-            write<NEG2>(static_cast<uint8_t>((neg >>  8) & 0xFFu));
-            return shadow;
+            v = insert<NEG1>(static_cast<uint8_t>( neg        & 0xFFu), v);
+            v = insert<NEG2>(static_cast<uint8_t>((neg >>  8) & 0xFFu), v);
+            return v;
+        }
+    };
+
+    // ===== RAM PROFILE (64-bit, PROFILE0..7 addresses while CFR1.RAM_ENABLE = 1) =====
+    // Same serial addresses as the single tone profiles, only the layout differs.
+    // Layout given for PROFILE0; profile n is at address + n.
+    struct RAM_PROFILE : Register<0x0E, 8> {
+        static constexpr uint16_t RAM_WORDS = 1024;  // 1024 × 32-bit
+
+        using STEP_RATE_MSB = Field<48,8>;  // [55:48] address step rate
+        using STEP_RATE_LSB = Field<40,8>;  // [47:40]
+        using END_MSB       = Field<32,8>;  // [39:32] end address [9:2]
+        using END_LSB       = Field<30,2>;  // [31:30] end address [1:0]
+        using START_MSB     = Field<16,8>;  // [23:16] start address [9:2]
+        using START_LSB     = Field<14,2>;  // [15:14] start address [1:0]
+        using NO_DWELL_HIGH = Field<5>;     // [5] no-dwell high (ramp-up: jump back to start)
+        using ZERO_CROSSING = Field<3>;     // [3] phase change on zero crossing (direct switch only)
+        using MODE          = Field<0,3>;   // [2:0] RAM profile mode control
+
+        enum class Mode : uint8_t {
+            DirectSwitch            = 0,    // start address word only
+            RampUp                  = 1,    // start → end once, then hold
+            Bidirectional           = 2,    // PROFILE0 pin selects up / down (RAM profile 0 only)
+            ContinuousBidirectional = 3,    // start ↔ end, forever
+            ContinuousRecirculate   = 4     // start → end, wrap, forever
+        };
+
+        static constexpr value_type set_ram(uint16_t start, uint16_t end, uint16_t step_rate,
+                                            Mode mode, bool no_dwell_high = false,
+                                            bool zero_crossing = false) {
+            value_type v{};
+            v = insert<STEP_RATE_MSB>(static_cast<uint8_t>(step_rate >> 8), v);
+            v = insert<STEP_RATE_LSB>(static_cast<uint8_t>(step_rate & 0xFFu), v);
+            v = insert<END_MSB      >(static_cast<uint8_t>((end   >> 2) & 0xFFu), v);
+            v = insert<END_LSB      >(static_cast<uint8_t>((end   & 0x3u) << 6), v);
+            v = insert<START_MSB    >(static_cast<uint8_t>((start >> 2) & 0xFFu), v);
+            v = insert<START_LSB    >(static_cast<uint8_t>((start & 0x3u) << 6), v);
+            v = set   <NO_DWELL_HIGH>(no_dwell_high, v);
+            v = set   <ZERO_CROSSING>(zero_crossing, v);
+            v = insert<MODE         >(static_cast<uint8_t>(mode), v);
+            return v;
+        }
+
+        static constexpr uint16_t start_of(value_type v) {
+            return static_cast<uint16_t>((uint16_t(extract<START_MSB>(v)) << 2) | (extract<START_LSB>(v) >> 6));
+        }
+        static constexpr uint16_t end_of(value_type v) {
+            return static_cast<uint16_t>((uint16_t(extract<END_MSB>(v)) << 2) | (extract<END_LSB>(v) >> 6));
         }
     };
 
+    // ===== RAM WORDS (32-bit, sent MSB first) =====
+    // Bit position of each parameter in a RAM word, by CFR1.RAM_DEST
+    namespace ram_word {
+        constexpr uint32_t ftw(uint32_t ftw)                { return ftw; }                         // [31:0]
+        constexpr uint32_t pow(uint16_t pow)                { return uint32_t(pow) << 16; }         // [31:16]
+        constexpr uint32_t asf(uint16_t asf)                { return uint32_t(asf & 0x3FFFu) << 18; } // [31:18]
+        constexpr uint32_t polar(uint16_t pow, uint16_t asf){ return (uint32_t(pow) << 16) |        // [31:16]
+                                                                     (uint32_t(asf & 0x3FFFu) << 2); } // [15:2]
+    } // namespace ram_word
+
+    // ---- Parallel port destinations, F[1:0] pin code ----
+    enum class ParDest : uint8_t {
+        Amplitude = 0,      // D[15:2] → ASF
+        Phase     = 1,      // D[15:0] → POW
+        Frequency = 2,      // FTW register + (D[15:0] << FM gain)
+        Polar     = 3       // D[15:8] → ASF[13:6], D[7:0] → POW[15:8]
+    };
+
+    // ---- 16-bit parallel port words, per destination ----
+    namespace par_word {
+        constexpr uint16_t asf(uint16_t asf)                { return uint16_t((asf & 0x3FFFu) << 2); }
+        constexpr uint16_t pow(uint16_t pow)                { return pow; }
+        constexpr uint16_t ftw(uint32_t delta_ftw, uint8_t fm_gain) {                   // above the FTW register
+                                                              return uint16_t(delta_ftw >> (fm_gain & 0x0Fu)); }
+        constexpr uint16_t polar(uint16_t pow, uint16_t asf){ return uint16_t(((asf & 0x3FFFu) >> 6) << 8 | (pow >> 8)); }
+    } // namespace par_word
+
     // ===== SINGLE TONE PROFILES (64-bit) =====
     struct PROFILE0 : PROFILE<0x0E> {};
     struct PROFILE1 : PROFILE<0x0F> {};
@@ -337,4 +558,96 @@ namespace ad9910_reg {
     struct PROFILE6 : PROFILE<0x14> {};
     struct PROFILE7 : PROFILE<0x15> {};
 
+
+    // ----------------------------------------
+    //             FIXED FRAMES
+    // ----------------------------------------
+    // Configurations that don't depend on the context, folded to SPI frames at compile time
+    namespace fixed {
+        inline constexpr FixedReg<CFR1>    CFR1_DEFAULTS       { CFR1::defaults()              };
+        inline constexpr FixedReg<CFR1>    CFR1_DRG_SETUP      { CFR1::drg_setup()             };
+        inline constexpr FixedReg<CFR2>    CFR2_DEFAULTS       { CFR2::defaults()              };
+        inline constexpr FixedReg<CFR2>    CFR2_DRG_FREQ       { CFR2::drg_freq_enable(false)  };
+        inline constexpr FixedReg<CFR2>    CFR2_DRG_FREQ_CONT  { CFR2::drg_freq_enable(true)   };
+        inline constexpr FixedReg<AUX_DAC> AUX_DAC_FSC_NORMAL  { AUX_DAC::defaults(false)      };
+        inline constexpr FixedReg<AUX_DAC> AUX_DAC_FSC_HIGH    { AUX_DAC::defaults(true)       };
+    } // namespace fixed
+
+
+    // ----------------------------------------
+    //             REGISTER BANK
+    // ----------------------------------------
+    // Per-device image of every register that IO_UPDATE latches (all but RAM). Each AD9910
+    // owns one, so several chips on one MCU keep independent CFR/DRG/profile state. Values
+    // are what was last written successfully (staged, i.e. active after the next IO_UPDATE).
+    struct RegisterBank {
+        CFR1::value_type        cfr1;
+        CFR2::value_type        cfr2;
+        CFR3::value_type        cfr3;
+        AUX_DAC::value_type     aux_dac;
+        IO_UPDATE_RATE::value_type io_rate;
+        FTW::value_type         ftw;
+        POW::value_type         pow;
+        ASF::value_type         asf;
+        MULTICHIP_SYNC::value_type mc_sync;
+        DR_LIMIT::value_type    dr_limit;
+        DR_STEP::value_type     dr_step;
+        DR_RATE::value_type     dr_rate;
+        RegValue<8>             profile[8];
+
+        // Records a raw value by serial address (RAM and reserved addresses are ignored)
+        void store(uint8_t addr, uint64_t v) {
+            switch (addr) {
+                case CFR1::address:     cfr1     = CFR1::value_type(v);     break;
+                case CFR2::address:     cfr2     = CFR2::value_type(v);     break;
+                case CFR3::address:     cfr3     = CFR3::value_type(v);     break;
+                case AUX_DAC::address:  aux_dac  = AUX_DAC::value_type(v);  break;
+                case IO_UPDATE_RATE::address: io_rate = IO_UPDATE_RATE::value_type(v); break;
+                case FTW::address:      ftw      = FTW::value_type(v);      break;
+                case POW::address:      pow      = POW::value_type(v);      break;
+                case ASF::address:      asf      = ASF::value_type(v);      break;
+                case MULTICHIP_SYNC::address: mc_sync = MULTICHIP_SYNC::value_type(v); break;
+                case DR_LIMIT::address: dr_limit = DR_LIMIT::value_type(v); break;
+                case DR_STEP::address:  dr_step  = DR_STEP::value_type(v);  break;
+                case DR_RATE::address:  dr_rate  = DR_RATE::value_type(v);  break;
+                default:
+                    if (addr >= PROFILE0::address && addr <= PROFILE7::address)
+                        profile[addr - PROFILE0::address] = RegValue<8>(v);
+                    break;
+            }
+        }
+
+        // Raw value by serial address; false for RAM and reserved addresses
+        bool load(uint8_t addr, uint64_t& v) const {
+            switch (addr) {
+                case CFR1::address:     v = cfr1.val;     return true;
+                case CFR2::address:     v = cfr2.val;     return true;
+                case CFR3::address:     v = cfr3.val;     return true;
+                case AUX_DAC::address:  v = aux_dac.val;  return true;
+                case IO_UPDATE_RATE::address: v = io_rate.val; return true;
+                case FTW::address:      v = ftw.val;      return true;
+                case POW::address:      v = pow.val;      return true;
+                case ASF::address:      v = asf.val;      return true;
+                case MULTICHIP_SYNC::address: v = mc_sync.val; return true;
+                case DR_LIMIT::address: v = dr_limit.val; return true;
+                case DR_STEP::address:  v = dr_step.val;  return true;
+                case DR_RATE::address:  v = dr_rate.val;  return true;
+                default:
+                    if (addr < PROFILE0::address || addr > PROFILE7::address) return false;
+                    v = profile[addr - PROFILE0::address].val;
+                    return true;
+            }
+        }
+
+        // Datasheet power-on / MASTER_RESET state
+        static constexpr RegisterBank power_on() {
+            RegisterBank b{};
+            b.cfr2    = CFR2::value_type(0x00400820u);
+            b.cfr3    = CFR3::value_type(0x1F3F4000u);
+            b.aux_dac = AUX_DAC::value_type(0x7Fu);
+            b.io_rate = IO_UPDATE_RATE::value_type(0xFFFFFFFFu);
+            return b;
+        }
+    };
+
 } // namespace ad9910_reg
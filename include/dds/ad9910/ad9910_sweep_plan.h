@@ -0,0 +1,89 @@
+#pragma once
+#include "core_types.h"
+#include "ad9910.h"
+
+// ----------------------------------------
+//            AD9910 SWEEP PLAN
+// ----------------------------------------
+// Piecewise-linear chirp through (freq, time) breakpoints, up, down or flat, played as a
+// chain of DRG segments (dds_freq_sweep only does one up-ramp).
+//
+// compile() turns the breakpoints into ready-to-clock DR_LIMIT / DR_STEP / DR_RATE frames,
+// one set per segment, with step / rate fitted to the exact DRG tick count
+// (ad9910_math::drg_fit). Each segment aims at the absolute time of its end point, so the
+// quantisation error of one segment is taken back by the next instead of adding up.
+// Re-arming a segment is then only the burst + IO_UPDATE + DRCTL, no math.
+//
+//   SweepPlan::segment_t seg[N - 1];
+//   SweepPlan::compile(dds, points, N, seg);
+//   plan.start(seg, N - 1);                      // Rearm::DROVER
+//   while (plan.service()) {}                    // or next() from a timer every current_ns()
+//
+// Times exclude the re-arm latency itself (SPI burst + IO_UPDATE): the output dwells on
+// the breakpoint frequency for that long, phase continuous.
+class SweepPlan {
+public:
+    static constexpr uint8_t FRAME_BYTES = 3 + ad9910_reg::DR_LIMIT::length
+                                             + ad9910_reg::DR_STEP::length
+                                             + ad9910_reg::DR_RATE::length;
+
+    // DROVER re-arm sees a segment end only if service() polls between the arm and the
+    // limit: arm's own return, the pin read and ISRs (Timer0 on the Mega) take up to ~10 us.
+    // Shorter segments could go low → high unseen and stall the plan, so they need TIMER;
+    // the loop around service() must also come back within this window.
+    static constexpr uint64_t DROVER_MIN_NS = 100000u;
+
+    enum class Rearm : uint8_t { DROVER, TIMER };
+    enum class Dir   : uint8_t { UP, DOWN, HOLD };
+
+    struct point_t {
+        uint32_t freq_hz;
+        uint64_t t_ns;              // from the chirp start, strictly increasing
+    };
+
+    struct segment_t {
+        uint8_t  frames[FRAME_BYTES];   // DR_LIMIT, DR_STEP, DR_RATE, back to back
+        Dir      dir;
+        uint32_t ftw_start;
+        uint64_t duration_ns;           // as the chip will run it
+    };
+
+    explicit SweepPlan(AD9910& dds) : dds_(dds) {}
+
+    // n breakpoints → n - 1 segments in out. DDS_INVALID_PARAM for n < 2 or times not
+    // increasing. *max_error_ns: worst |achieved end − breakpoint time| over the plan.
+    static dds_status_t compile(const AD9910& dds,
+                                const point_t* pts,
+                                size_t n,
+                                segment_t* out,
+                                uint64_t* max_error_ns = nullptr);
+
+    // Parks the output on the first frequency and arms segment 0. A flat segment never
+    // raises DROVER, so Rearm::DROVER rejects plans containing one, or a segment shorter
+    // than DROVER_MIN_NS (DDS_INVALID_PARAM).
+    dds_status_t start(const segment_t* segs, size_t n, Rearm mode = Rearm::DROVER);
+
+    // DROVER mode, from the main loop: arms the next segment once the current one has
+    // reached its limit (DROVER low → high after arming). Returns true while running.
+    bool service();
+
+    // Arms the next segment now (timer mode: call current_ns() after the previous arm)
+    dds_status_t next();
+
+    void stop() { segs_ = nullptr; count_ = 0; }
+
+    bool     done()       const { return done_; }
+    size_t   segment()    const { return pos_; }
+    uint64_t current_ns() const { return segs_ ? segs_[pos_].duration_ns : 0; }
+
+private:
+    AD9910&           dds_;
+    const segment_t*  segs_      = nullptr;
+    size_t            count_     = 0;
+    size_t            pos_       = 0;
+    Rearm             mode_      = Rearm::DROVER;
+    bool              seen_low_  = false;
+    bool              done_      = false;
+
+    dds_status_t arm(size_t i);
+};
@@ -73,6 +73,12 @@ public:
                                         bool continuous) = 0;
 
     virtual uint32_t dds_freq_ftw(uint32_t freq_hz) const = 0;
+
+    // Whole list at once, same rounding as dds_freq_ftw. Default: one call per entry.
+    virtual void dds_freq_ftw_batch(const uint32_t* freq_hz, uint32_t* ftw_out, size_t n) const {
+        if (!freq_hz || !ftw_out) return;
+        for (size_t i = 0; i < n; i++) ftw_out[i] = dds_freq_ftw(freq_hz[i]);
+    }
     
     // ------------ Implemented Functions ------------
     dds_status_t dds_init();     // ✅ calls sub steps init
@@ -107,10 +113,12 @@ protected:
     // --- Sequences Helpers (implemented by Subclasses) ---
     dds_status_t dds_seq_run(const DdsSequence* seq, size_t count);           // ✅🤔
     virtual const DdsSequence* get_seq_setup(size_t& count) const = 0;
+    virtual void dds_seq_step_hook(const DdsSequence& /*step*/) {}            // called after each applied step
 
     // --- Initialization sub-steps --- 
     virtual dds_status_t dds_validate_context() = 0;  // ✅ device-specific context
     dds_status_t dds_attach_board(const pin_t* pins, size_t pins_count); // ✅
+    virtual dds_status_t dds_attach_hook() { return dds_status_t::DDS_OK; }  // pin_indices_ just resolved
     dds_status_t dds_setup_pins();                   // ✅ 🤔 runs the setup sequence
     dds_status_t spi_init();                         // ✅
     virtual dds_status_t dds_setup_reg()  = 0;       // ✅ 🤔 initializes device-specific registers 
@@ -0,0 +1,175 @@
+#pragma once
+#include "core_types.h"
+#include "dds/dds_base.h"
+#include "boards/board_abstraction.h"
+
+// ----------------------------------------
+//          HOST ↔ BOARD BINARY PROTOCOL
+// ----------------------------------------
+// Replaces the OG ASCII marker protocol (getDataFromPC: one char per loop(), atol per value).
+//
+//   [SYNC 0xA5][LEN][CMD][PAYLOAD × LEN][CRC16 lo][CRC16 hi]
+//
+// LEN counts payload bytes only (0..MAX_PAYLOAD). CRC-16/CCITT-FALSE (poly 0x1021, init
+// 0xFFFF) over LEN, CMD and PAYLOAD. Every multi-byte field is little-endian, the byte order
+// of AVR and Cortex-M, so an FTW / POW / ASF lands in a profile or RAM table as is.
+//
+// The encoder is plain C++ with no Arduino dependency: host tools include this header and
+// link dds_protocol.cpp. The board side is SerialLink on top of HWAbstraction's raw serial.
+namespace dds_proto {
+
+    static constexpr uint8_t SYNC        = 0xA5;
+    static constexpr uint8_t MAX_PAYLOAD = 242;                 // offset + 60 words / 30 entries
+    static constexpr uint8_t OVERHEAD    = 5;                   // SYNC, LEN, CMD, CRC16
+    static constexpr size_t  MAX_FRAME   = MAX_PAYLOAD + OVERHEAD;
+
+    // Commands (host → board unless noted)
+    enum cmd_t : uint8_t {
+        CMD_PING        = 0x01,     // -                                   → ACK
+        CMD_FTW_LIST    = 0x10,     // [u16 offset][u32 ftw]×n             → table[offset..)
+        CMD_ENTRY_LIST  = 0x11,     // [u16 offset]([u32 ftw][u16 pow][u16 asf])×n
+        CMD_PROFILE     = 0x12,     // [u8 slot][u32 ftw][u16 pow][u16 asf]
+        CMD_RAM_WORDS   = 0x13,     // [u16 addr][u32 word]×n              → RAM image[addr..)
+        CMD_START       = 0x20,     // [u16 count]
+        CMD_STOP        = 0x21,     // -
+        CMD_ACK         = 0x7E,     // board → host: [u8 cmd]
+        CMD_NAK         = 0x7F,     // board → host: [u8 cmd][i8 dds_status_t]
+    };
+
+    static constexpr uint8_t WORD_HEADER  = 2;                  // u16 offset / address
+    static constexpr uint8_t ENTRY_BYTES  = 8;
+    static constexpr uint8_t PROFILE_BYTES= 9;
+    static constexpr uint8_t WORDS_MAX    = (MAX_PAYLOAD - WORD_HEADER) / 4;
+    static constexpr uint8_t ENTRIES_MAX  = (MAX_PAYLOAD - WORD_HEADER) / ENTRY_BYTES;
+
+    // ---- Little-endian fields ----
+    inline void     put_u16(uint8_t* p, uint16_t v) { p[0] = uint8_t(v); p[1] = uint8_t(v >> 8); }
+    inline void     put_u32(uint8_t* p, uint32_t v) { put_u16(p, uint16_t(v)); put_u16(p + 2, uint16_t(v >> 16)); }
+    inline uint16_t get_u16(const uint8_t* p) { return uint16_t(p[0] | (uint16_t(p[1]) << 8)); }
+    inline uint32_t get_u32(const uint8_t* p) { return get_u16(p) | (uint32_t(get_u16(p + 2)) << 16); }
+
+    uint16_t crc16(const uint8_t* data, size_t len, uint16_t crc = 0xFFFFu);
+
+    // ---- Encoder (host side, also used for the board's replies) ----
+    // Each returns the frame length written to out, 0 if it doesn't fit in cap or the
+    // arguments are invalid. The list encoders take as many items as one frame holds
+    // (WORDS_MAX / ENTRIES_MAX) and report that count in *used; call again with the rest.
+    size_t encode(uint8_t cmd, const uint8_t* payload, uint8_t len, uint8_t* out, size_t cap);
+    size_t encode_words(uint8_t cmd, uint16_t offset, const uint32_t* words, size_t n,
+                        uint8_t* out, size_t cap, size_t* used);
+    size_t encode_profile(uint8_t slot, uint32_t ftw, uint16_t pow, uint16_t asf,
+                          uint8_t* out, size_t cap);
+    size_t encode_u16(uint8_t cmd, uint16_t v, uint8_t* out, size_t cap);
+
+    // E: any struct with ftw / pow / asf members (ProfileSequencer::entry_t)
+    template<typename E>
+    size_t encode_entries(uint16_t offset, const E* entries, size_t n,
+                          uint8_t* out, size_t cap, size_t* used) {
+        if (!entries || n == 0) return 0;
+        const size_t k = (n < ENTRIES_MAX) ? n : ENTRIES_MAX;
+        uint8_t payload[MAX_PAYLOAD];
+        put_u16(payload, offset);
+        for (size_t i = 0; i < k; ++i) {
+            uint8_t* p = payload + WORD_HEADER + i * ENTRY_BYTES;
+            put_u32(p, entries[i].ftw);
+            put_u16(p + 4, entries[i].pow);
+            put_u16(p + 6, entries[i].asf);
+        }
+        const size_t len = encode(CMD_ENTRY_LIST, payload, uint8_t(WORD_HEADER + k * ENTRY_BYTES), out, cap);
+        if (used) *used = len ? k : 0;
+        return len;
+    }
+
+    // ---- Payload → tables (board side) ----
+    // FTW_LIST / RAM_WORDS into table[offset..offset+n). DDS_INVALID_PARAM when the payload
+    // is malformed or runs past cap; the table is left untouched then. *end = offset + n.
+    dds_status_t unpack_words(const uint8_t* payload, uint8_t len,
+                              uint32_t* table, size_t cap, size_t* end = nullptr);
+
+    template<typename E>
+    dds_status_t unpack_entries(const uint8_t* payload, uint8_t len,
+                                E* table, size_t cap, size_t* end = nullptr) {
+        if (!payload || !table || len < WORD_HEADER || (len - WORD_HEADER) % ENTRY_BYTES != 0)
+            return dds_status_t::DDS_INVALID_PARAM;
+        const size_t offset = get_u16(payload);
+        const size_t n      = (len - WORD_HEADER) / ENTRY_BYTES;
+        if (offset + n > cap) return dds_status_t::DDS_INVALID_PARAM;
+        for (size_t i = 0; i < n; ++i) {
+            const uint8_t* p = payload + WORD_HEADER + i * ENTRY_BYTES;
+            table[offset + i].ftw = get_u32(p);
+            table[offset + i].pow = get_u16(p + 4);
+            table[offset + i].asf = get_u16(p + 6);
+        }
+        if (end) *end = offset + n;
+        return dds_status_t::DDS_OK;
+    }
+
+
+    // ----------------------------------------
+    //               DECODER
+    // ----------------------------------------
+    // Byte-at-a-time. The bytes of the frame being received are kept from its SYNC on; a bad
+    // length or CRC drops only that SYNC and the search restarts on the byte after it, over
+    // the bytes already received. A lost or corrupted byte therefore costs the frame it was
+    // in and nothing after it, and a 0xA5 inside a payload can't hide the frames behind it.
+    // A frame found in the rescanned bytes is reported by resume() (or the next push()).
+    // While a candidate found by such a rescan is incomplete, a complete CRC-valid frame
+    // behind its SYNC is taken instead of waiting out a false length.
+    class FrameDecoder {
+    public:
+        enum class result_t : uint8_t { PENDING, FRAME, ERROR };
+
+        // FRAME: cmd() / payload() / len() are valid until the next push() / resume()
+        result_t push(uint8_t b);
+        result_t resume();                      // next frame already buffered, no new byte
+        void     reset() { n_ = 0; done_ = 0; resynced_ = false; }
+
+        uint8_t        cmd()     const { return raw_[2]; }
+        uint8_t        len()     const { return raw_[1]; }
+        const uint8_t* payload() const { return raw_ + 3; }
+        uint32_t       errors()  const { return errors_; }   // dropped candidates (bad LEN / CRC)
+
+    private:
+        uint8_t  raw_[MAX_FRAME] = {};          // [SYNC][LEN][CMD]... of the current candidate
+        uint8_t  n_      = 0;                   // bytes held in raw_
+        uint8_t  done_   = 0;                   // length of the frame last reported, dropped next call
+        bool     resynced_ = false;             // head found by rescanning a dropped candidate
+        uint32_t errors_ = 0;
+
+        result_t scan();
+        void     drop(uint8_t k);
+        bool     valid_at(uint8_t j, uint8_t end, bool exact) const;
+    };
+
+
+    // ----------------------------------------
+    //              SERIAL LINK
+    // ----------------------------------------
+    // Board end: drains hw_serial_read() into the decoder, from loop() like the OG parser,
+    // but a whole frame per call instead of one character.
+    //
+    //   if (link.poll()) {
+    //       const auto& f = link.frame();
+    //       dds_status_t s = handle(f.cmd(), f.payload(), f.len());
+    //       link.reply(f.cmd(), s);
+    //   }
+    class SerialLink {
+    public:
+        explicit SerialLink(HWAbstraction& hw) : hw_(hw) {}
+
+        // True when a complete, CRC-checked frame is ready in frame(). Stops right after
+        // it, the bytes behind it stay in the UART buffer for the next call.
+        bool poll();
+
+        const FrameDecoder& frame() const { return dec_; }
+
+        dds_status_t send(uint8_t cmd, const uint8_t* payload, uint8_t len);
+        // ACK on DDS_OK, NAK carrying the status otherwise
+        dds_status_t reply(uint8_t cmd, dds_status_t status);
+
+    private:
+        HWAbstraction& hw_;
+        FrameDecoder   dec_;
+    };
+
+} // namespace dds_proto
@@ -0,0 +1,86 @@
+#pragma once
+#include "core_types.h"
+
+// ----------------------------------------
+//          SINGLE PRODUCER / CONSUMER RING
+// ----------------------------------------
+// Lock-free FIFO between exactly one producer (serial RX interrupt, DMA completion) and one
+// consumer (main loop). No critical sections: each index is written by one side only and
+// published with release / read with acquire. Indices are free-running uint8_t, so a load
+// or store is a single instruction on AVR too and N is limited to 128.
+//
+// Besides push / pop, both ends expose contiguous spans for block transfers: a DMA channel
+// fills write_span() and the completion handler calls commit(n); the consumer can do the
+// same with read_span() / release(n). Two DMA half-transfers back to back give the usual
+// double buffer.
+//
+// overruns() is 8-bit (saturating at 255) so the consumer's read is a single load even
+// when the producer is an AVR interrupt.
+template<typename T, uint8_t N>
+class SpscRing {
+    static_assert(N >= 2 && N <= 128 && (N & (N - 1)) == 0, "SpscRing: N must be a power of two in 2..128");
+public:
+    static constexpr uint8_t CAPACITY = N;
+
+    // ---- Producer ----
+    bool push(const T& v) {
+        const uint8_t h = own(head_);
+        if (uint8_t(h - acquire(tail_)) == N) { note_overrun(); return false; }
+        slots_[h & MASK] = v;
+        store(head_, uint8_t(h + 1));
+        return true;
+    }
+
+    // Free slots up to the wrap point, *n of them
+    T* write_span(uint8_t* n) {
+        const uint8_t h    = own(head_);
+        const uint8_t free = uint8_t(N - uint8_t(h - acquire(tail_)));
+        const uint8_t end  = uint8_t(N - (h & MASK));
+        *n = free < end ? free : end;
+        return &slots_[h & MASK];
+    }
+    void commit(uint8_t n) { store(head_, uint8_t(own(head_) + n)); }
+
+    // Producer had to drop data it couldn't place (full ring, UART / DMA overflow)
+    void note_overrun() { if (own(overruns_) != 0xFFu) store(overruns_, uint8_t(own(overruns_) + 1)); }
+
+    // ---- Consumer ----
+    bool pop(T& out) {
+        const uint8_t t = own(tail_);
+        if (t == acquire(head_)) return false;
+        out = slots_[t & MASK];
+        store(tail_, uint8_t(t + 1));
+        return true;
+    }
+
+    // Filled slots up to the wrap point, *n of them
+    const T* read_span(uint8_t* n) const {
+        const uint8_t t     = own(tail_);
+        const uint8_t avail = uint8_t(acquire(head_) - t);
+        const uint8_t end   = uint8_t(N - (t & MASK));
+        *n = avail < end ? avail : end;
+        return &slots_[t & MASK];
+    }
+    void release(uint8_t n) { store(tail_, uint8_t(own(tail_) + n)); }
+
+    // ---- Either side (a snapshot, the other side may move it) ----
+    uint8_t  size()     const { return uint8_t(acquire(head_) - acquire(tail_)); }
+    bool     empty()    const { return size() == 0; }
+    bool     full()     const { return size() == N; }
+    uint8_t  overruns() const { return acquire(overruns_); }
+
+    // Only while neither side is running
+    void reset() { head_ = 0; tail_ = 0; overruns_ = 0; }
+
+private:
+    static constexpr uint8_t MASK = N - 1;
+
+    static uint8_t own(const uint8_t& v)         { return __atomic_load_n(&v, __ATOMIC_RELAXED); }   // the side's own index
+    static uint8_t acquire(const uint8_t& v)     { return __atomic_load_n(&v, __ATOMIC_ACQUIRE); }   // the other side's
+    static void    store(uint8_t& v, uint8_t x)  { __atomic_store_n(&v, x, __ATOMIC_RELEASE); }
+
+    T        slots_[N];
+    uint8_t  head_     = 0;     // written by the producer only
+    uint8_t  tail_     = 0;     // written by the consumer only
+    uint8_t  overruns_ = 0;     // producer side, saturating
+};
@@ -12,6 +12,7 @@
 // ----------------------------------------
 // Defines a compile-time bitfield located within one byte, using BIT and WIDTH to derive mask and position.
 // Provides read, write, and reset helpers that operate on a 64-bit register value with zero runtime computation
+// All helpers are constexpr and side-effect free: they take a value and return a new one.
 template<unsigned BIT, uint8_t WIDTH = 1>
 struct Field {
 
@@ -26,9 +27,9 @@ struct Field {
     static constexpr uint64_t MASK64 = uint64_t(BYTE_MASK) << (BYTE_INDEX * 8u);
 
     // read/write use these precomputed constants
-    static uint64_t clear(uint64_t v) { return v & ~MASK64;}
-    static uint8_t extract(uint64_t v) { return uint8_t((v & MASK64) >> (BYTE_INDEX * 8u));}
-    static uint64_t insert(uint8_t x, uint64_t v) {
+    static constexpr uint64_t clear(uint64_t v) { return v & ~MASK64;}
+    static constexpr uint8_t extract(uint64_t v) { return uint8_t((v & MASK64) >> (BYTE_INDEX * 8u));}
+    static constexpr uint64_t insert(uint8_t x, uint64_t v) {
         v &= ~MASK64;
         v |= uint64_t(x & BYTE_MASK) << (BYTE_INDEX * 8u);
         return v;
@@ -37,6 +38,25 @@ struct Field {
 };
 
 
+// ----------------------------------------
+//              FixedReg
+// ----------------------------------------
+// A register configuration known at compile time: the value and its ready-to-send
+// write frame. Declared as `static constexpr` / `inline constexpr`, all the field
+// composition and byte packing is folded by the compiler; at run time the driver only
+// copies bytes to the bus.
+template<typename RegT>
+struct FixedReg {
+    using reg_type   = RegT;
+    using value_type = typename RegT::value_type;
+
+    value_type                                  value;
+    std::array<uint8_t, RegT::length + 1>       frame;
+
+    constexpr explicit FixedReg(value_type v) : value(v), frame(RegT::frame(v)) {}
+};
+
+
 // ----------------------------------------
 //               PACK_BYTES
 // ----------------------------------------
@@ -49,7 +69,7 @@ struct Field {
 // out[3] = byte 0 (LSB)
 // Used mainly in ReValue
 template<size_t N>
-std::array<uint8_t, N> pack_be(uint64_t v) {
+constexpr std::array<uint8_t, N> pack_be(uint64_t v) {
     std::array<uint8_t, N> out{};
     for (size_t i = 0; i < N; i++) {
         size_t shift = (N - 1 - i) * 8;
@@ -58,6 +78,13 @@ std::array<uint8_t, N> pack_be(uint64_t v) {
     return out;
 }
 
+// Inverse of pack_be: N big-endian bytes back into the low bits of a 64-bit value
+constexpr uint64_t unpack_be(const uint8_t* in, size_t n) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; i++) v = (v << 8) | in[i];
+    return v;
+}
+
 // ----------------------------------------
 //               REGVALUE
 // ----------------------------------------
@@ -74,8 +101,8 @@ struct RegValue {
             : ((storage_t(1) << (LEN_BYTES * 8)) - 1ull);
 
     storage_t val = 0;
-    RegValue() = default;
-    explicit RegValue(storage_t raw_val) : val(raw_val & REG_MASK) {}
+    constexpr RegValue() = default;
+    constexpr explicit RegValue(storage_t raw_val) : val(raw_val & REG_MASK) {}
 
 };
 
@@ -83,41 +110,49 @@ struct RegValue {
 //              Register
 // ----------------------------------------
 // Template representing a hardware register at a specific address with a defined length in bytes.
+// Stateless: it only knows the layout. The value lives with whoever owns the device
+// (e.g. a per-instance register bank), so two chips on one MCU never share an image.
+//
+//   constexpr auto v = CFR::set<EN>(true, CFR::insert<MODE>(0x0C));
 template<std::uintptr_t Addr, std::size_t LEN_BYTES>
 struct Register {
     static constexpr std::uintptr_t address = Addr;
+    static constexpr std::size_t    length  = LEN_BYTES;
     using value_type = RegValue<LEN_BYTES>;
-    static value_type shadow;
 
     template<typename FieldT>
-    static void clear(value_type &v = shadow) {
-        v.val = FieldT::clear(v.val) & value_type::REG_MASK;
+    static constexpr value_type clear(value_type v) {
+        return value_type(FieldT::clear(v.val));
     }
 
     template<typename FieldT>
-    static uint8_t extract(const value_type &v = shadow) {
+    static constexpr uint8_t extract(value_type v) {
         return FieldT::extract(v.val);
     }
 
+    // x is the raw in-byte bit pattern (already shifted to the field position)
     template<typename FieldT>
-    static void insert(uint8_t x , value_type &v = shadow) {
-        v.val = FieldT::insert(x, v.val) & value_type::REG_MASK;
+    static constexpr value_type insert(uint8_t x, value_type v = value_type{}) {
+        return value_type(FieldT::insert(x, v.val));
     }
 
     // Use for single-bit fields
     template<typename FieldT>
-    static void set( bool on, value_type &v = shadow) {
-        insert<FieldT>(on ? 0xFF : 0,v);
+    static constexpr value_type set(bool on, value_type v = value_type{}) {
+        return insert<FieldT>(on ? 0xFF : 0, v);
     }
 
-    static std::array<uint8_t, LEN_BYTES> bytes(const value_type &v = shadow) {
+    static constexpr std::array<uint8_t, LEN_BYTES> bytes(value_type v) {
         return pack_be<LEN_BYTES>(v.val & value_type::REG_MASK);
     }
 
-};
-
-template<std::uintptr_t Addr, std::size_t LEN_BYTES>
-typename Register<Addr, LEN_BYTES>::value_type
-Register<Addr, LEN_BYTES>::shadow{};
-
+    // Complete write frame: [instruction = address, R/W bit clear][payload, MSB first]
+    static constexpr std::array<uint8_t, LEN_BYTES + 1> frame(value_type v) {
+        std::array<uint8_t, LEN_BYTES + 1> out{};
+        const auto b = bytes(v);
+        out[0] = static_cast<uint8_t>(Addr & 0x7Fu);
+        for (size_t i = 0; i < LEN_BYTES; i++) out[i + 1] = b[i];
+        return out;
+    }
 
+};
@@ -118,6 +118,11 @@ void ArduinoBoard::hw_delay_ms(uint32_t ms) { ::delay(ms); }
 void ArduinoBoard::hw_serial_begin(uint32_t baud) {Serial.begin(baud);}
 void ArduinoBoard::hw_serial_write(const char* s) { if (!s) return; Serial.print(s);}
 void ArduinoBoard::hw_serial_writeln(const char* s) { if (!s) return; Serial.println(s);}
+int16_t ArduinoBoard::hw_serial_read() { return static_cast<int16_t>(Serial.read()); }   // -1 when empty
+HWAbstraction::hw_status_t ArduinoBoard::hw_serial_write_bytes(const uint8_t* data, uint16_t len) {
+    if (!data || len == 0) return HW_INVALID_ARG;
+    return (Serial.write(data, len) == len) ? HW_OK : HW_ERROR;
+}
 
 
 
@@ -9,6 +9,7 @@ ArduinoMega::ArduinoMega() {}
 
 // Definition of the static pin meta table declared in ArduinoDue
 ArduinoBoard::hw_pin_meta_t ArduinoMega::s_gpio_pins[ArduinoMega::HW_MAX_PINS]; 
+ArduinoMega::hw_pin_fast_t  ArduinoMega::s_gpio_fast[ArduinoMega::HW_MAX_PINS];
 
 // =============== Private helpers ===============
 ArduinoBoard::hw_pin_meta_t* ArduinoMega::hw_pin_get_meta(uint8_t pin){
@@ -115,6 +116,11 @@ HWAbstraction::hw_status_t ArduinoMega::hw_pin_attach(const pin_t& pin){
     meta->pull      = static_cast<uint8_t>(pin.pull);       // e.g. NONE / PULLUP
     meta->attached  = 1; 
 
+    // 5. Resolve the hot path: PORTx address + mask
+    hw_pin_fast_t& fast = s_gpio_fast[idx];
+    fast.out  = static_cast<volatile uint8_t*>(hw_port_base_from_index(meta->port_ix));
+    fast.mask = arduino_mask;
+
     // Attach
     hw_pin_mode(idx, pin.mode);
 
@@ -122,6 +128,70 @@ HWAbstraction::hw_status_t ArduinoMega::hw_pin_attach(const pin_t& pin){
 }
 
 
+// ---- Fast GPIO ----
+// Single read-modify-write on PORTx. Ports H..L sit above the sbi/cbi range, so the
+// RMW is guarded against ISRs touching the same port (SREG saved, not blindly sei'd).
+// Unlike digitalWrite there is no PWM timer shutdown: attached DDS pins are never PWM.
+HWAbstraction::hw_status_t ArduinoMega::hw_pin_write(uint8_t pin, hw_pin_value_t value) {
+    if (pin >= HW_MAX_PINS) return HW_INVALID_PIN;
+    const hw_pin_fast_t& f = s_gpio_fast[pin];
+    if (!f.out) return ArduinoBoard::hw_pin_write(pin, value);
+
+    const uint8_t sreg = SREG;
+    cli();
+    switch (value) {
+        case HW_PIN_LOW:  *f.out &= uint8_t(~f.mask); break;
+        case HW_PIN_HIGH: *f.out |= f.mask;           break;
+        default: SREG = sreg; return HW_INVALID_ARG;
+    }
+    SREG = sreg;
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t ArduinoMega::hw_pin_read(uint8_t pin, hw_pin_value_t* value) {
+    if (!value) return HW_INVALID_ARG;
+    if (pin >= HW_MAX_PINS) return HW_INVALID_PIN;
+    const hw_pin_fast_t& f = s_gpio_fast[pin];
+    if (!f.out) return ArduinoBoard::hw_pin_read(pin, value);
+
+    const volatile uint8_t* in = f.out - 2;                 // PINx, DDRx, PORTx are consecutive
+    *value = (*in & f.mask) ? HW_PIN_HIGH : HW_PIN_LOW;
+    return HW_OK;
+}
+
+// ---- Ports ----
+bool ArduinoMega::hw_pin_port(uint8_t pin, uint8_t* port, uint32_t* mask) const {
+    if (!port || !mask || pin >= HW_MAX_PINS) return false;
+    const hw_pin_meta_t& m = s_gpio_pins[pin];
+    if (!m.attached) return false;
+    *port = m.port_ix;              // Arduino port id (PA..PL)
+    *mask = m.bit_mask;
+    return true;
+}
+
+HWAbstraction::hw_status_t ArduinoMega::hw_port_write_masked(uint8_t port, uint32_t mask, uint32_t value) {
+    if (mask > 0xFFu) return HW_INVALID_ARG;
+    volatile uint8_t* out = static_cast<volatile uint8_t*>(hw_port_base_from_index(port));
+    if (!out) return HW_INVALID_ARG;
+
+    const uint8_t m = static_cast<uint8_t>(mask);
+    const uint8_t sreg = SREG;
+    cli();
+    *out = uint8_t((*out & ~m) | (static_cast<uint8_t>(value) & m));
+    SREG = sreg;
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t ArduinoMega::hw_pin_toggle(uint8_t pin) {
+    if (pin >= HW_MAX_PINS) return HW_INVALID_PIN;
+    const hw_pin_fast_t& f = s_gpio_fast[pin];
+    if (!f.out) return ArduinoBoard::hw_pin_toggle(pin);
+
+    *(f.out - 2) = f.mask;                                  // writing 1 to PINx toggles PORTx (atomic)
+    return HW_OK;
+}
+
+
 // =============== SPI - ArduinoMegaBoard ===============
 
 // ---- Validate SPI Config ----
@@ -0,0 +1,537 @@
+#include "boards/native/board_native_sim.h"
+#include <cstring>
+
+constexpr NativeSimBoard::sim_cost_model_t NativeSimBoard::kMegaCostModel;
+
+// Power-on defaults of the non-zero registers (datasheet register map)
+namespace {
+    struct sim_default_t { uint8_t addr; uint32_t value; };
+    constexpr sim_default_t kPowerOnDefaults[] = {
+        { 0x01, 0x00400820u },  // CFR2
+        { 0x02, 0x1F3F4000u },  // CFR3
+        { 0x03, 0x0000007Fu },  // AUX_DAC
+        { 0x04, 0xFFFFFFFFu },  // IO_UPDATE_RATE
+    };
+}
+
+NativeSimBoard::NativeSimBoard(const sim_cost_model_t& cost, const std::array<pin_t, kPinCount>& pins)
+    : cost_(cost),
+      pins_(pins),
+      cs_ix_          (index_of(pins[idx(DdsPin::SPI_CS)])),
+      io_update_ix_   (index_of(pins[idx(DdsPin::IO_UPDATE)])),
+      master_reset_ix_(index_of(pins[idx(DdsPin::MASTER_RESET)])),
+      io_reset_ix_    (index_of(pins[idx(DdsPin::IO_RESET)])),
+      profile_ix_{ index_of(pins[idx(DdsPin::PROFILE0)]),
+                   index_of(pins[idx(DdsPin::PROFILE1)]),
+                   index_of(pins[idx(DdsPin::PROFILE2)]) }
+{
+    set_level(cs_ix_, true);    // CS idles high (pull-up on the shield)
+    reset_banks();
+}
+
+// =============== Private helpers ===============
+uint8_t NativeSimBoard::index_of(const pin_t& pin) {
+    if (!pin_has_port_pin(pin) || pin.port >= HW_PORT_COUNT || pin.pin >= 8u) return PIN_U8_UNKNOWN;
+    return static_cast<uint8_t>(pin.port * 8u + pin.pin);
+}
+
+void NativeSimBoard::advance_cycles(uint32_t cycles) {
+    if (cost_.cpu_hz == 0) return;
+    stats_.time_ns += (static_cast<uint64_t>(cycles) * 1000000000ull) / cost_.cpu_hz;
+}
+
+void NativeSimBoard::set_level(uint8_t ix, bool high) {
+    const uint8_t mask = uint8_t(1u << (ix & 7));
+    if (high) port_out_[ix >> 3] |=  mask;
+    else      port_out_[ix >> 3] &= ~mask;
+}
+
+void NativeSimBoard::reset_banks() {
+    std::memset(&staged_, 0, sizeof(staged_));
+    for (const auto& d : kPowerOnDefaults) {
+        const auto b = pack_be<4>(d.value);
+        std::memcpy(staged_.r[d.addr], b.data(), b.size());
+    }
+    active_ = staged_;
+    phase_  = spi_phase_t::INSTRUCTION;
+}
+
+// Pin edge decoding: CS frames the serial port, IO_UPDATE latches, MASTER_RESET resets
+void NativeSimBoard::on_edge(uint8_t ix, bool high) {
+    if (ix == cs_ix_) {
+        if (!high) {
+            ++stats_.cs_assertions;
+            phase_ = spi_phase_t::INSTRUCTION;
+            if (!update_window_open_) {
+                update_window_open_ = true;
+                update_window_t0_   = stats_.time_ns;
+            }
+        } else if (phase_ == spi_phase_t::DATA) {
+            ++stats_.protocol_errors;       // CS released in the middle of a register
+            phase_ = spi_phase_t::INSTRUCTION;
+        }
+    } else if (ix == io_update_ix_ && high) {
+        ++stats_.io_updates;
+        active_ = staged_;
+        stats_.last_update_bytes      = update_window_bytes_;
+        stats_.last_update_latency_ns = update_window_open_ ? stats_.time_ns - update_window_t0_ : 0;
+        update_window_open_  = false;
+        update_window_bytes_ = 0;
+    } else if (ix == master_reset_ix_ && high) {
+        ++stats_.master_resets;
+        reset_banks();
+        update_window_open_  = false;
+        update_window_bytes_ = 0;
+    } else if (ix == io_reset_ix_ && high) {
+        phase_ = spi_phase_t::INSTRUCTION;  // IO_RESET aborts the current serial cycle
+    }
+}
+
+void NativeSimBoard::note_profile() {
+    const uint8_t p = sim_profile();
+    if (p != last_profile_) { ++stats_.profile_changes; last_profile_ = p; }
+}
+
+// One byte on the serial port while CS is low. Returns the SDO byte.
+uint8_t NativeSimBoard::spi_clock_byte(uint8_t mosi) {
+    ++stats_.spi_bytes;
+    advance_cycles(cost_.spi_byte_cycles);
+    if (cfg_.spi_clock_hz)
+        stats_.time_ns += 8000000000ull / cfg_.spi_clock_hz;
+
+    if (level(cs_ix_)) return cfg_.read_dummy;  // chip not selected
+    ++update_window_bytes_;
+
+    if (phase_ == spi_phase_t::INSTRUCTION) {
+        cur_addr_ = mosi & 0x1Fu;
+        cur_read_ = (mosi & ad9910_reg::SPI_READ) != 0;
+        cur_len_  = ad9910_reg::reg_len(cur_addr_);
+        cur_pos_  = 0;
+        if (cur_addr_ == static_cast<uint8_t>(ad9910_reg::Reg::RAM)) {
+            // Length set by the selected RAM profile (active bank)
+            const auto prof = ad9910_reg::RAM_PROFILE::value_type(
+                reg_value(active_, static_cast<ad9910_reg::Reg>(ad9910_reg::RAM_PROFILE::address + sim_profile())));
+            const uint16_t start = ad9910_reg::RAM_PROFILE::start_of(prof);
+            const uint16_t end   = ad9910_reg::RAM_PROFILE::end_of(prof);
+            if (end < start || end >= RAM_WORDS) { ++stats_.protocol_errors; return 0; }
+            ram_start_ = start;
+            cur_len_   = uint16_t((end - start + 1u) * 4u);
+        }
+        if (cur_len_ == 0) { ++stats_.protocol_errors; return 0; }
+        phase_ = spi_phase_t::DATA;
+        return 0;
+    }
+
+    uint8_t miso = 0;
+    uint8_t* cell = (cur_addr_ == static_cast<uint8_t>(ad9910_reg::Reg::RAM))
+                  ? &ram_[ram_start_ + cur_pos_ / 4u][cur_pos_ % 4u]       // RAM bypasses the I/O buffers
+                  : (cur_read_ ? &active_.r[cur_addr_][cur_pos_] : &staged_.r[cur_addr_][cur_pos_]);
+    if (cur_read_) miso = *cell;
+    else           *cell = mosi;
+
+    if (++cur_pos_ == cur_len_) {
+        // The next byte is a new instruction byte (datasheet: serial I/O cycle complete)
+        if (cur_read_) ++stats_.reads; else ++stats_.frames;
+        phase_ = spi_phase_t::INSTRUCTION;
+    }
+    return miso;
+}
+
+uint64_t NativeSimBoard::reg_value(const sim_bank_t& bank, ad9910_reg::Reg reg) const {
+    const uint8_t addr = static_cast<uint8_t>(reg);
+    const uint8_t len  = ad9910_reg::reg_len(addr);
+    uint64_t v = 0;
+    for (uint8_t i = 0; i < len; ++i) v = (v << 8) | bank.r[addr][i];
+    return v;
+}
+
+
+// =============== GPIO ===============
+uint8_t NativeSimBoard::hw_pin_to_index(const pin_t& pin) const { return index_of(pin); }
+
+void* NativeSimBoard::hw_port_base_from_index(uint8_t port_ix) const {
+    if (port_ix >= HW_PORT_COUNT) return nullptr;
+    return const_cast<uint8_t*>(&port_out_[port_ix]);
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_pin_validate(const pin_t& pin) {
+    if (!pin_has_port_pin(pin)) return HW_INVALID_PIN;
+    return index_of(pin) == PIN_U8_UNKNOWN ? HW_INVALID_PIN : HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_pin_attach(const pin_t& pin) {
+    ++stats_.hw_calls;
+    const hw_status_t st = hw_pin_validate(pin);
+    if (st != HW_OK) return st;
+    return hw_pin_mode(index_of(pin), pin.mode);
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_pin_mode(uint8_t pin, pin_mode_t mode) {
+    ++stats_.hw_calls;
+    if (pin >= HW_MAX_PINS) return HW_INVALID_PIN;
+    const uint8_t mask = uint8_t(1u << (pin & 7));
+    switch (mode) {
+        case PIN_INPUT:  port_dir_[pin >> 3] &= ~mask; break;
+        case PIN_OUTPUT: port_dir_[pin >> 3] |=  mask; break;
+        case PIN_ALT:
+        default:
+            return HW_INVALID_ARG;
+    }
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_pin_write(uint8_t pin, hw_pin_value_t value) {
+    ++stats_.hw_calls;
+    ++stats_.pin_writes;
+    advance_cycles(cost_.pin_write_cycles);
+    if (pin >= HW_MAX_PINS) return HW_INVALID_PIN;
+    if (value != HW_PIN_LOW && value != HW_PIN_HIGH) return HW_INVALID_ARG;
+
+    const bool high = (value == HW_PIN_HIGH);
+    const bool old  = level(pin);
+    set_level(pin, high);
+    if (old != high) on_edge(pin, high);
+    note_profile();
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_pin_read(uint8_t pin, hw_pin_value_t* value) {
+    ++stats_.hw_calls;
+    advance_cycles(cost_.pin_write_cycles);
+    if (!value) return HW_INVALID_ARG;
+    if (pin >= HW_MAX_PINS) return HW_INVALID_PIN;
+    *value = level(pin) ? HW_PIN_HIGH : HW_PIN_LOW;
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_pin_toggle(uint8_t pin) {
+    if (pin >= HW_MAX_PINS) return HW_INVALID_PIN;
+    return hw_pin_write(pin, level(pin) ? HW_PIN_LOW : HW_PIN_HIGH);
+}
+
+bool NativeSimBoard::hw_pin_port(uint8_t pin, uint8_t* port, uint32_t* mask) const {
+    if (!port || !mask || pin >= HW_MAX_PINS) return false;
+    *port = pin >> 3;
+    *mask = 1u << (pin & 7);
+    return true;
+}
+
+// All bits change in the same instant, edges are decoded afterwards
+HWAbstraction::hw_status_t NativeSimBoard::hw_port_write_masked(uint8_t port, uint32_t mask, uint32_t value) {
+    ++stats_.hw_calls;
+    ++stats_.port_writes;
+    advance_cycles(cost_.pin_write_cycles);
+    if (port >= HW_PORT_COUNT || mask > 0xFFu) return HW_INVALID_ARG;
+
+    const uint8_t old     = port_out_[port];
+    port_out_[port]       = uint8_t((old & ~mask) | (value & mask));
+    const uint8_t changed = uint8_t(old ^ port_out_[port]);
+    for (uint8_t b = 0; b < 8; ++b)
+        if (changed & (1u << b)) on_edge(uint8_t(port * 8u + b), (port_out_[port] >> b) & 1u);
+    note_profile();
+    return HW_OK;
+}
+
+
+// =============== SPI ===============
+uint8_t NativeSimBoard::hw_spi_mode() const { return cfg_.mode; }
+HWAbstraction::hw_status_t NativeSimBoard::hw_spi_config() { return HW_OK; }
+
+// The AD9910 serial port is specified up to 70 MHz, MSB first is the only mode the sim decodes
+HWAbstraction::hw_status_t NativeSimBoard::hw_spi_validate_config(const spi_config_t& cfg) {
+    constexpr uint32_t kMaxSpiHz = 70000000u;
+    if (cfg.spi_clock_hz == 0 || cfg.spi_clock_hz > kMaxSpiHz) return HW_INVALID_ARG;
+    if (cfg.mode > 3)      return HW_INVALID_ARG;
+    if (cfg.bit_order != 0) return HW_INVALID_ARG;
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_spi_init(const spi_config_t& cfg) {
+    ++stats_.hw_calls;
+    if (initialized_) return HW_OK;
+    auto st = hw_spi_validate_config(cfg);
+    if (st != HW_OK) return st;
+    cfg_ = cfg;
+    st = hw_spi_config();
+    if (st != HW_OK) return st;
+    initialized_ = true;
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_spi_reset() {
+    ++stats_.hw_calls;
+    phase_ = spi_phase_t::INSTRUCTION;
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_spi_transfer(const uint8_t* tx_data, uint8_t* rx_data, uint16_t len) {
+    ++stats_.hw_calls;
+    if (!initialized_) return HW_NOT_INIT;
+    if (!tx_data || len == 0) return HW_INVALID_ARG;
+    ++stats_.spi_calls;
+    advance_cycles(cost_.spi_call_cycles);
+    for (uint16_t i = 0; i < len; ++i) {
+        const uint8_t r = spi_clock_byte(tx_data[i]);
+        if (rx_data) rx_data[i] = r;
+    }
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_spi_write(const uint8_t* data, uint16_t len) {
+    ++stats_.hw_calls;
+    if (!initialized_) return HW_NOT_INIT;
+    if (!data || len == 0) return HW_INVALID_ARG;
+    ++stats_.spi_calls;
+    advance_cycles(cost_.spi_call_cycles);
+    for (uint16_t i = 0; i < len; ++i) spi_clock_byte(data[i]);
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_spi_read(uint8_t* data, uint16_t len) {
+    ++stats_.hw_calls;
+    if (!initialized_) return HW_NOT_INIT;
+    if (!data || len == 0) return HW_INVALID_ARG;
+    ++stats_.spi_calls;
+    advance_cycles(cost_.spi_call_cycles);
+    for (uint16_t i = 0; i < len; ++i) data[i] = spi_clock_byte(cfg_.read_dummy);
+    return HW_OK;
+}
+
+
+// =============== Delays ===============
+void NativeSimBoard::hw_delay_us(uint32_t us) { ++stats_.hw_calls; stats_.time_ns += uint64_t(us) * 1000ull; }
+void NativeSimBoard::hw_delay_ms(uint32_t ms) { ++stats_.hw_calls; stats_.time_ns += uint64_t(ms) * 1000000ull; }
+
+
+// =============== Parallel bus ===============
+HWAbstraction::hw_status_t NativeSimBoard::hw_parallel_start(const uint16_t* words, uint32_t count,
+                                                             uint32_t period_ns, bool circular) {
+    ++stats_.hw_calls;
+    advance_cycles(cost_.spi_call_cycles);                  // timer / DMA channel set-up
+    if (!words || count == 0 || period_ns == 0) return HW_INVALID_ARG;
+    par_words_     = words;
+    par_count_     = count;
+    par_period_ns_ = period_ns;
+    par_circular_  = circular;
+    par_t0_        = int64_t(stats_.time_ns);
+    par_running_   = true;
+    return HW_OK;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_parallel_stop() {
+    ++stats_.hw_calls;
+    advance_cycles(cost_.pin_write_cycles);
+    par_stopped_ = hw_parallel_position();
+    par_running_ = false;
+    return HW_OK;
+}
+
+// Word i goes on the bus at t0 + i × period
+uint32_t NativeSimBoard::hw_parallel_position() const {
+    if (!par_running_) return par_stopped_;
+    const uint64_t n = uint64_t(int64_t(stats_.time_ns) - par_t0_) / par_period_ns_ + 1u;
+    if (!par_circular_ && n > par_count_) return par_count_;
+    return n > 0xFFFFFFFFull ? 0xFFFFFFFFu : uint32_t(n);
+}
+
+
+// =============== Serial ===============
+int16_t NativeSimBoard::hw_serial_read() {
+    ++stats_.hw_calls;
+    if (serial_rx_head_ >= serial_rx_.size()) return -1;
+    ++stats_.serial_rx_bytes;
+    const uint8_t b = serial_rx_[serial_rx_head_++];
+    if (serial_rx_head_ == serial_rx_.size()) { serial_rx_.clear(); serial_rx_head_ = 0; }
+    return b;
+}
+
+HWAbstraction::hw_status_t NativeSimBoard::hw_serial_write_bytes(const uint8_t* data, uint16_t len) {
+    ++stats_.hw_calls;
+    if (!data || len == 0) return HW_INVALID_ARG;
+    serial_tx_.insert(serial_tx_.end(), data, data + len);
+    stats_.serial_tx_bytes += len;
+    return HW_OK;
+}
+
+
+// =============== Simulator inspection ===============
+void NativeSimBoard::sim_reset_stats() {
+    par_t0_ -= int64_t(stats_.time_ns);                     // the bus keeps its place
+    stats_ = sim_stats_t{};
+    last_profile_ = sim_profile();
+    update_window_open_  = false;
+    update_window_bytes_ = 0;
+}
+
+uint64_t NativeSimBoard::sim_active(ad9910_reg::Reg reg) const { return reg_value(active_, reg); }
+uint64_t NativeSimBoard::sim_staged(ad9910_reg::Reg reg) const { return reg_value(staged_, reg); }
+
+uint8_t NativeSimBoard::sim_profile() const {
+    return uint8_t( (level(profile_ix_[0]) ? 1u : 0u) |
+                    (level(profile_ix_[1]) ? 2u : 0u) |
+                    (level(profile_ix_[2]) ? 4u : 0u) );
+}
+
+uint32_t NativeSimBoard::sim_ram(uint16_t addr) const {
+    if (addr >= RAM_WORDS) return 0;
+    return uint32_t(unpack_be(ram_[addr], 4));
+}
+
+uint16_t NativeSimBoard::sim_parallel_word() const {
+    const uint32_t n = hw_parallel_position();
+    if (!par_words_ || n == 0) return 0;
+    return par_words_[(n - 1u) % par_count_];
+}
+
+// Single tone from the selected profile unless CFR2[4] hands the F[1:0] destination to the
+// port; then FTW / POW come from their own registers (0x07 / 0x08)
+NativeSimBoard::sim_core_t NativeSimBoard::sim_core() const {
+    const uint64_t prof = reg_value(active_, static_cast<ad9910_reg::Reg>(ad9910_reg::PROFILE0::address + sim_profile()));
+    sim_core_t c = { uint32_t(prof), uint16_t(prof >> 32), uint16_t((prof >> 48) & 0x3FFFu) };
+    const uint32_t cfr2 = uint32_t(reg_value(active_, ad9910_reg::Reg::CFR2));
+    if (!(cfr2 & 0x10u)) return c;                                          // CFR2[4] parallel port
+
+    c.ftw = uint32_t(reg_value(active_, ad9910_reg::Reg::FTW));
+    c.pow = uint16_t(reg_value(active_, ad9910_reg::Reg::POW));
+    const bool     tx   = sim_pin_level(pins_[idx(DdsPin::TX_ENABLE)]);
+    const bool     hold = (cfr2 & 0x40u) != 0;                               // CFR2[6] hold last value
+    const uint16_t d    = (tx || hold) ? sim_parallel_word() : 0u;
+    const uint8_t  f    = uint8_t((sim_pin_level(pins_[idx(DdsPin::F0)]) ? 1u : 0u) |
+                                  (sim_pin_level(pins_[idx(DdsPin::F1)]) ? 2u : 0u));
+    switch (f) {
+        case 0: c.asf = uint16_t(d >> 2);                                       break;
+        case 1: c.pow = d;                                                      break;
+        case 2: c.ftw = c.ftw + (uint32_t(d) << (cfr2 & 0x0Fu));                break;    // FM gain
+        default:
+            c.asf = uint16_t((d >> 8) << 6);
+            c.pow = uint16_t((d & 0xFFu) << 8);
+            break;
+    }
+    return c;
+}
+
+bool NativeSimBoard::sim_pin_level(const pin_t& pin) const {
+    const uint8_t ix = index_of(pin);
+    return ix != PIN_U8_UNKNOWN && level(ix);
+}
+
+bool NativeSimBoard::sim_pin_output(const pin_t& pin) const {
+    const uint8_t ix = index_of(pin);
+    return ix != PIN_U8_UNKNOWN && (port_dir_[ix >> 3] & (1u << (ix & 7))) != 0;
+}
+
+void NativeSimBoard::sim_set_pin_level(const pin_t& pin, bool high) {
+    const uint8_t ix = index_of(pin);
+    if (ix != PIN_U8_UNKNOWN) set_level(ix, high);
+}
+
+void NativeSimBoard::sim_serial_inject(const uint8_t* data, size_t len) {
+    if (data) serial_rx_.insert(serial_rx_.end(), data, data + len);
+}
+
+size_t NativeSimBoard::sim_serial_take(uint8_t* out, size_t max) {
+    const size_t n = (serial_tx_.size() < max) ? serial_tx_.size() : max;
+    if (!out || n == 0) return 0;
+    std::memcpy(out, serial_tx_.data(), n);
+    serial_tx_.erase(serial_tx_.begin(), serial_tx_.begin() + static_cast<std::ptrdiff_t>(n));
+    return n;
+}
+
+
+// =============== Shared bus ===============
+bool NativeSimBus::sim_attach(NativeSimBoard& chip) {
+    if (extra_ + 1u >= MAX_CHIPS || &chip == this) return false;
+    chips_[extra_++] = &chip;
+    return true;
+}
+
+void NativeSimBus::sim_reset_stats_all() {
+    for (uint8_t i = 0; i < sim_chip_count(); ++i) sim_chip(i).sim_reset_stats();
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_pin_attach(const pin_t& pin) {
+    const hw_status_t st = NativeSimBoard::hw_pin_attach(pin);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_pin_attach(pin);
+    return st;
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_pin_mode(uint8_t pin, pin_mode_t mode) {
+    const hw_status_t st = NativeSimBoard::hw_pin_mode(pin, mode);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_pin_mode(pin, mode);
+    return st;
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_pin_write(uint8_t pin, hw_pin_value_t value) {
+    const hw_status_t st = NativeSimBoard::hw_pin_write(pin, value);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_pin_write(pin, value);
+    return st;
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_pin_toggle(uint8_t pin) {
+    const hw_status_t st = NativeSimBoard::hw_pin_toggle(pin);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_pin_toggle(pin);
+    return st;
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_port_write_masked(uint8_t port, uint32_t mask, uint32_t value) {
+    const hw_status_t st = NativeSimBoard::hw_port_write_masked(port, mask, value);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_port_write_masked(port, mask, value);
+    return st;
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_spi_init(const spi_config_t& cfg) {
+    const hw_status_t st = NativeSimBoard::hw_spi_init(cfg);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_spi_init(cfg);
+    return st;
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_spi_reset() {
+    const hw_status_t st = NativeSimBoard::hw_spi_reset();
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_spi_reset();
+    return st;
+}
+
+void NativeSimBus::or_reads(NativeSimBoard& chip, const uint8_t* tx, uint8_t* rx, uint16_t len) {
+    uint8_t tmp[32];
+    for (uint16_t i = 0; i < len; ) {
+        const uint16_t left = uint16_t(len - i);
+        const uint16_t n    = left < sizeof(tmp) ? left : uint16_t(sizeof(tmp));
+        if (tx) chip.hw_spi_transfer(tx + i, tmp, n);
+        else    chip.hw_spi_read(tmp, n);
+        for (uint16_t k = 0; k < n; ++k) rx[i + k] |= tmp[k];
+        i = uint16_t(i + n);
+    }
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_spi_transfer(const uint8_t* tx_data, uint8_t* rx_data, uint16_t len) {
+    const hw_status_t st = NativeSimBoard::hw_spi_transfer(tx_data, rx_data, len);
+    if (st != HW_OK) return st;
+    for (uint8_t i = 0; i < extra_; ++i) {
+        if (rx_data) or_reads(*chips_[i], tx_data, rx_data, len);
+        else         chips_[i]->hw_spi_transfer(tx_data, nullptr, len);
+    }
+    return st;
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_spi_write(const uint8_t* data, uint16_t len) {
+    const hw_status_t st = NativeSimBoard::hw_spi_write(data, len);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_spi_write(data, len);
+    return st;
+}
+
+HWAbstraction::hw_status_t NativeSimBus::hw_spi_read(uint8_t* data, uint16_t len) {
+    const hw_status_t st = NativeSimBoard::hw_spi_read(data, len);
+    if (st != HW_OK) return st;
+    for (uint8_t i = 0; i < extra_; ++i) or_reads(*chips_[i], nullptr, data, len);
+    return st;
+}
+
+void NativeSimBus::hw_delay_us(uint32_t us) {
+    NativeSimBoard::hw_delay_us(us);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_delay_us(us);
+}
+
+void NativeSimBus::hw_delay_ms(uint32_t ms) {
+    NativeSimBoard::hw_delay_ms(ms);
+    for (uint8_t i = 0; i < extra_; ++i) chips_[i]->hw_delay_ms(ms);
+}
@@ -1,27 +1,19 @@
-#include <cmath>
+#include <cstring>
 #include "dds/dds_base.h"
 #include "dds/ad9910/ad9910.h"
 #include "dds/ad9910/ad9910_registers.h"
 #include "dds/ad9910/ad9910_pins.h"
+#include "dds/ad9910/ad9910_math.h"
+
+using VcoSel  = ad9910_reg::CFR3::VcoSel;
+using IcpCode = ad9910_reg::CFR3::IcpCode;
 
 // ----------------------------------------
 //               👩‍⚕️ Helpers 
 // ----------------------------------------
-static uint16_t calc_ampl_scale_factor(int16_t ampl_db){ //🤔 Check me 
-    // 10^((ampl_db + 84.288) / 20) < 1  ⇔  ampl_db <= -85
-    // --- Handle edge cases --------------------------------------------------
-    if (ampl_db <= -85) { return 0;         }
-    if (ampl_db >= 0)   { return 0x3FFFu;   }
-
-    // --- General case -------------------------------------------------------
-    static constexpr float kDbOffset   = 84.288f;
-    static constexpr float kInvTwenty  = 1.0f / 20.0f;
-    static constexpr uint32_t kMaxAsf  = 0x3FFFu;
-    const float exponent = (static_cast<float>(ampl_db) + kDbOffset) * kInvTwenty;
-    const float asf_f    = std::pow(10.0f, exponent);
-    uint32_t asf_u = static_cast<uint32_t>(asf_f);
-    if (asf_u > kMaxAsf) { asf_u = kMaxAsf;}
-    return static_cast<uint16_t>(asf_u);
+// dB → ASF, integer only (ad9910_math.cpp)
+static uint16_t calc_ampl_scale_factor(int16_t ampl_db){
+    return ad9910_math::asf_from_db(ampl_db);
 }
 
 static bool convert_to_ns(SweepTimeFormat fmt, int64_t duration, uint64_t& ns_out){
@@ -63,12 +55,11 @@ static VcoSel pick_vco_sel(uint64_t clk) {
 }
 
 uint32_t AD9910::dds_freq_ftw(uint32_t freq_hz) const{
-    const uint32_t sysclk = dds_sysclk_hz();
-    if (sysclk == 0 || freq_hz == 0) { return 0;}
-    if (freq_hz >= sysclk) { return 0xFFFFFFFFu;}       // If req freq ≥ sysclk, the ideal FTW ≥ 2^32 → saturate
-    const uint64_t numerator = (uint64_t)freq_hz << 32; // FTW = round( freq_hz * 2^32 / sysclk )
-    const uint64_t rounded   = numerator + (sysclk / 2u);
-    return static_cast<uint32_t>(rounded / sysclk);
+    return ad9910_math::ftw_from_hz(freq_hz, ftw_recip_);     // round(f × 2^32 / sysclk), exact
+}
+
+void AD9910::dds_freq_ftw_batch(const uint32_t* freq_hz, uint32_t* ftw_out, size_t n) const{
+    ad9910_math::ftw_from_hz_batch(freq_hz, ftw_out, n, ftw_recip_);
 }
 
 // ----------------------------------------
@@ -76,11 +67,12 @@ uint32_t AD9910::dds_freq_ftw(uint32_t freq_hz) const{
 // ----------------------------------------
 AD9910::AD9910(HWAbstraction& hw,
                const HWAbstraction::spi_config_t& spi_cfg,
-               const AD9910Context& ad9910_ctx)
+               const AD9910Context& ad9910_ctx,
+               const std::array<pin_t, kPinCount>& pins)
     : DDSBase(hw,
               spi_cfg,
-              dds_pins().data(),                  // pointer to first pin_t
-              dds_pins().size())   // number of pins
+              pins.data(),                  // pointer to first pin_t
+              pins.size())   // number of pins
     , ad9910_ctx_(ad9910_ctx)
 {}
 
@@ -90,6 +82,55 @@ const DDSBase::DdsSequence* AD9910::get_seq_setup(size_t& count) const {
     return seq_setup_.data();
 }
 
+// A MASTER_RESET pulse puts every register back to its power-on default
+void AD9910::dds_seq_step_hook(const DdsSequence& step) {
+    if (step.pin_index == idx(DdsPin::MASTER_RESET) && step.level == HWAbstraction::HW_PIN_HIGH) {
+        reg_cache_.invalidate_all();
+        regs_ = ad9910_reg::RegisterBank::power_on();
+    }
+}
+
+dds_status_t AD9910::dds_attach_hook() {
+    static constexpr DdsPin kProfilePins[3] = { DdsPin::PROFILE0, DdsPin::PROFILE1, DdsPin::PROFILE2 };
+    profile_port_count_ = 0;
+    profile_port_t groups[3] = {};
+    uint8_t n = 0;
+    for (uint8_t k = 0; k < 3; ++k) {
+        uint8_t port; uint32_t mask;
+        if (!hw_.hw_pin_port(pin_indices_[idx(kProfilePins[k])], &port, &mask))
+            return dds_status_t::DDS_OK;                    // no port access: per-pin writes
+        uint8_t g = 0;
+        while (g < n && groups[g].port != port) ++g;
+        if (g == n) groups[n++].port = port;
+        groups[g].mask       |= mask;
+        groups[g].bit_mask[k] = mask;
+    }
+    for (uint8_t g = 0; g < n; ++g) profile_ports_[g] = groups[g];
+    profile_port_count_ = n;
+    return dds_status_t::DDS_OK;
+}
+
+// Drives PROFILE[2:0] = index & 7 with the fewest port writes
+dds_status_t AD9910::dds_profile_select(uint8_t index) {
+    dds_status_t s = dds_status_t::DDS_OK;
+    if (profile_port_count_ == 0) {
+        auto lvl = [index](uint8_t bit) {
+            return (index & bit) ? HWAbstraction::HW_PIN_HIGH : HWAbstraction::HW_PIN_LOW; };
+        TRY_OK( pin_write(idx(DdsPin::PROFILE0), lvl(0x01)) ,s,s);
+        TRY_OK( pin_write(idx(DdsPin::PROFILE1), lvl(0x02)) ,s,s);
+        TRY_OK( pin_write(idx(DdsPin::PROFILE2), lvl(0x04)) ,s,s);
+        return s;
+    }
+    for (uint8_t g = 0; g < profile_port_count_; ++g) {
+        const profile_port_t& p = profile_ports_[g];
+        const uint32_t v = ((index & 0x01) ? p.bit_mask[0] : 0u) |
+                           ((index & 0x02) ? p.bit_mask[1] : 0u) |
+                           ((index & 0x04) ? p.bit_mask[2] : 0u);
+        TRY_OK( from_hw(hw_.hw_port_write_masked(p.port, p.mask, v)) ,s,s);
+    }
+    return s;
+}
+
 // --- AD9910-specifics : Base Overrides --- 🤔 Check me 
 dds_status_t AD9910::dds_validate_context() {
     auto &c = ad9910_ctx_;
@@ -107,6 +148,7 @@ dds_status_t AD9910::dds_validate_context() {
         this->ref_div2_  = false;       // REFCLK divider not used
         this->sysclk_hz_ = ref;         // SYSCLK = REFCLK in bypass
         this->vco_sel_   = 6;           // 110b = PLL bypass in CFR3
+        this->ftw_recip_ = ad9910_math::ftw_recip(static_cast<uint32_t>(ref));
 
         return dds_status_t::DDS_OK;
     }
@@ -142,36 +184,102 @@ dds_status_t AD9910::dds_validate_context() {
     // Cache for later use
     this->sysclk_hz_ = sysclk;
     this->vco_sel_   = static_cast<uint8_t>(vco);
+    this->ftw_recip_ = ad9910_math::ftw_recip(static_cast<uint32_t>(sysclk));
 
     return dds_status_t::DDS_OK;
 }
 
 dds_status_t AD9910::dds_setup_reg() { 
     dds_status_t s = dds_status_t::DDS_OK;
-    // ---- CFR1 ----
-    TRY_OK( dds_cfr1_defaults(),     s, s);
-    TRY_OK( dds_update_io_pulse(),  s, s);
-    // ---- CFR2 ----
-    TRY_OK( dds_cfr2_defaults(),    s, s);
-    TRY_OK( dds_update_io_pulse(),  s, s);
-    // ---- CFR3 ----
-    TRY_OK( dds_cfr3_defaults(  ref_div2_,
-                                ad9910_ctx_.pll_enable,
-                                ad9910_ctx_.pll_mult
-                                VcoSel::VCO5, IcpCode::u387) ,    s, s);
-    TRY_OK( dds_update_io_pulse(),  s, s);
-    // ---- AUX DAC (FSC) ----
-    TRY_OK( dds_program_aux_dac(),  s, s);
-    TRY_OK( dds_update_io_pulse(),  s, s);
+    RegisterBatch b;
+    dds_setup_batch(b);
+    TRY_OK( dds_reg_flush(b),       s, s);                                          // one CS assertion
+    TRY_OK( dds_update_io_pulse(),  s, s);                                          // all four go active together
     return s;}
 
+void AD9910::dds_setup_batch(RegisterBatch& b) const {
+    b.add(ad9910_reg::fixed::CFR1_DEFAULTS);                                        // ---- CFR1 ----
+    b.add(ad9910_reg::fixed::CFR2_DEFAULTS);                                        // ---- CFR2 ----
+    b.add<ad9910_reg::CFR3>(ad9910_reg::CFR3::defaults( ref_div2_,                  // ---- CFR3 ----
+                                ad9910_ctx_.pll_enable,
+                                static_cast<uint8_t>(ad9910_ctx_.pll_mult),
+                                VcoSel::VCO5, IcpCode::u387));
+    b.add(ad9910_ctx_.dac_high_current ? ad9910_reg::fixed::AUX_DAC_FSC_HIGH        // ---- AUX DAC (FSC) ----
+                                       : ad9910_reg::fixed::AUX_DAC_FSC_NORMAL);
+}
+
 uint64_t AD9910::dds_sysclk_hz() const { // 🤔 Check me
     return sysclk_hz_;  // set in dds_validate_context()
 }
 
 // --- Register programming helpers ---
+dds_status_t AD9910::dds_spi_burst(const uint8_t* buf, size_t len){
+    const uint8_t cs = pin_indices_[idx(DdsPin::SPI_CS)];
+    dds_status_t s = from_hw(hw_.hw_pin_write(cs, HWAbstraction::HW_PIN_LOW));
+    if (s == dds_status_t::DDS_OK) s = spi_tx(buf, len);
+    const dds_status_t r = from_hw(hw_.hw_pin_write(cs, HWAbstraction::HW_PIN_HIGH)); // always release CS
+    return s != dds_status_t::DDS_OK ? s : r;                                           // keep the first error
+}
+
+dds_status_t AD9910::dds_reg_write_frame(const uint8_t* frame, size_t len){
+    if (len < 2 || !frame)  return dds_status_t::DDS_INVALID_PARAM;
+    const uint8_t addr = frame[0] & 0x7Fu;
+    uint8_t patched[ad9910_reg::CFR2::length + 1];
+    if (io_internal_ && addr == ad9910_reg::CFR2::address && len == sizeof(patched)) {
+        memcpy(patched, frame, len);
+        cfr2_io_overlay(patched + 1);
+        frame = patched;
+    }
+    if (!reg_cache_.matches(addr, frame + 1, len - 1)) {
+        reg_cache_.invalidate(addr);
+        dds_status_t s = dds_status_t::DDS_OK;
+        TRY_OK( dds_spi_burst(frame, len) ,s,s);                   // header + payload in one go
+        reg_cache_.store(addr, frame + 1, len - 1);
+    }
+    // Raw writes keep the bank in step too (RAM is not banked)
+    if (len - 1 == ad9910_reg::reg_len(addr)) regs_.store(addr, unpack_be(frame + 1, len - 1));
+    return dds_status_t::DDS_OK;
+}
+
+dds_status_t AD9910::dds_reg_flush(RegisterBatch& batch){
+    if (batch.overflow()) { batch.clear(); return dds_status_t::DDS_INVALID_PARAM; }
+
+    // 0) Internal I/O update must survive any CFR2 image the caller built
+    if (io_internal_)
+        for (uint8_t i = 0; i < batch.count(); i++)
+            if (batch.entry(i).addr == ad9910_reg::CFR2::address) cfr2_io_overlay(batch.payload(i));
+
+    // 1) Drop what the chip already holds
+    batch.drop_if([this](uint8_t addr, const uint8_t* p, uint8_t len) {
+        return reg_cache_.matches(addr, p, len); });
+    if (batch.empty()) return dds_status_t::DDS_OK;
+
+    // 2) Unknown content until the burst completes
+    for (uint8_t i = 0; i < batch.count(); i++) reg_cache_.invalidate(batch.entry(i).addr);
+
+    // 3) Back-to-back frames, one CS assertion
+    const dds_status_t s = dds_spi_burst(batch.data(), batch.size());
+    if (s == dds_status_t::DDS_OK) {
+        for (uint8_t i = 0; i < batch.count(); i++) {
+            const auto& e = batch.entry(i);
+            reg_cache_.store(e.addr, batch.payload(i), e.len);
+            regs_.store(e.addr, unpack_be(batch.payload(i), e.len));
+        }
+    }
+    batch.clear();
+    return s;
+}
+
 dds_status_t AD9910::dds_reg_write(uint8_t addr, const uint8_t* data, size_t len){
     if (len == 0 || !data)  return dds_status_t::DDS_INVALID_PARAM;
+    if (len <= AD9910RegCache::REG_MAX_LEN) {               // register: one frame, one spi_tx
+        uint8_t frame[AD9910RegCache::REG_MAX_LEN + 1];
+        frame[0] = static_cast<uint8_t>(addr & 0x7Fu);
+        memcpy(&frame[1], data, len);
+        return dds_reg_write_frame(frame, len + 1);
+    }
+    // Long stream (RAM): header and payload sent separately, never cached nor banked
+    reg_cache_.invalidate(addr);
     const uint8_t cs_i = idx(DdsPin::SPI_CS);
     // 1) CS low
     dds_status_t s = pin_write(cs_i, HWAbstraction::HW_PIN_LOW);
@@ -186,6 +294,7 @@ dds_status_t AD9910::dds_reg_write(uint8_t addr, const uint8_t* data, size_t len
         return s;}
     TRY_OK( spi_tx(data,len)                               ,s,s); // 3) send payload
     TRY_OK( pin_write(cs_i, HWAbstraction::HW_PIN_HIGH)    ,s,s); // 4) CS high                          
+    reg_cache_.store(addr, data, len);
     return s;
 }
 
@@ -241,39 +350,22 @@ dds_status_t AD9910::dds_freq_sweep(uint32_t start_hz,
     // --------------------------------------------
     //  
     // -------------------------------------------- 
-    // 2) DRG timing
-    uint64_t sysclk = dds_sysclk_hz();
-    if (sysclk == 0) return dds_status_t::DDS_INVALID_PARAM;
-
-
-    const long double core_ghz = static_cast<long double>(sysclk) / 1.0e9L;
-    if (core_ghz <= 0.0L) return dds_status_t::DDS_INVALID_PARAM;
-
-    uint32_t ftw_step  = 1u;
-    uint16_t step_rate = 1u;
-
-    const long double base_ns =
-        (4.0L / core_ghz) *
-        static_cast<long double>(delta_ftw) *
-        static_cast<long double>(ftw_step);
-
-    if (base_ns <= 0.0L) return dds_status_t::DDS_INVALID_PARAM;
-
-    if (base_ns < desired_ns) {
-        long double mult = desired_ns / base_ns;
-        uint32_t sr = static_cast<uint32_t>(std::llround(mult));
-        if (sr == 0)     sr = 1;
-        if (sr > 0xFFFF) sr = 0xFFFF;
-        step_rate = static_cast<uint16_t>(sr);
-    } else if (base_ns > desired_ns) {
-        long double mult = base_ns / desired_ns;
-        uint32_t fs = static_cast<uint32_t>(std::llround(mult));
-        if (fs == 0)         fs = 1;
-        if (fs > delta_ftw)  fs = delta_ftw;
-        ftw_step = fs;
-    }
-
-    if (ftw_step == 0 || step_rate == 0) return dds_status_t::DDS_INVALID_PARAM;
+    // 2) DRG timing: bounded search over exact tick counts (drg_fit, ~400 candidates)
+    const uint64_t sysclk = dds_sysclk_hz();
+    if (sysclk == 0) return dds_status_t::DDS_NOT_INITIALIZED;
+    uint32_t ftw_step  = 1;
+    uint16_t step_rate = 1;
+    const uint64_t ticks = ad9910_math::drg_fit(delta_ftw, ad9910_math::drg_ticks_from_ns(desired_ns, sysclk),
+                                                ftw_step, step_rate);
+
+    // The ramp clamps on ftw_end, so the end error is the FTW quantisation of stop_hz only
+    const ad9910_math::u128_t f_end = ad9910_math::mul_u64(ftw_end, sysclk * 1000u);   // mHz × 2^32
+    const uint64_t end_mhz = ad9910_math::div_round_u128(f_end, 1ull << 32);
+    last_sweep_.ftw_step           = ftw_step;
+    last_sweep_.step_rate          = step_rate;
+    last_sweep_.achieved_ns        = ad9910_math::drg_ns_from_ticks(ticks, sysclk);
+    last_sweep_.duration_error_ns  = int64_t(last_sweep_.achieved_ns) - int64_t(desired_ns);
+    last_sweep_.end_freq_error_mhz = int32_t(int64_t(end_mhz) - int64_t(stop_hz) * 1000);
 
 
     // --------------------------------------------
@@ -283,19 +375,19 @@ dds_status_t AD9910::dds_freq_sweep(uint32_t start_hz,
 
 
     dds_status_t s = dds_status_t::DDS_OK; 
+    RegisterBatch b;
     // --- 3) Program CFR1 for digital ramp (OG DigitalRamp CFR1) ---
-    TRY_OK ( dds_drg_cfr1_sweep()  ,s,s)
+    b.add(ad9910_reg::fixed::CFR1_DRG_SETUP);
 
     // --- 4) Program DR_LIMIT, DR_STEP, DR_RATE (OG DigitalRamp) ---
-    TRY_OK ( dds_drg_program_range(ftw_start,ftw_end,ftw_step,step_rate)  ,s,s);
+    dds_drg_batch_range(b, ftw_start, ftw_end, ftw_step, step_rate);
 
     // --- 5) Enable DRG in CFR2 (frequency destination) ---
-    TRY_OK( dds_drg_enable_freq(continuous)  ,s,s);
+    b.add(continuous ? ad9910_reg::fixed::CFR2_DRG_FREQ_CONT : ad9910_reg::fixed::CFR2_DRG_FREQ);
+    TRY_OK( dds_reg_flush(b)  ,s,s);                                         // single CS assertion
 
     // --- 6) Select profile 0 and arm DRCTL (OG does this) ---
-    TRY_OK( pin_write(idx(DdsPin::PROFILE0), HWAbstraction::HW_PIN_LOW),  s, s ); // PROFILE[2:0] = 000 → profile 0
-    TRY_OK( pin_write(idx(DdsPin::PROFILE1), HWAbstraction::HW_PIN_LOW),  s, s );
-    TRY_OK( pin_write(idx(DdsPin::PROFILE2), HWAbstraction::HW_PIN_LOW),  s, s );
+    TRY_OK( dds_profile_select(0),  s, s );                                          // PROFILE[2:0] = 000 → profile 0
     TRY_OK( pin_write(idx(DdsPin::DRCTL),    HWAbstraction::HW_PIN_HIGH), s, s );  // DRCTL high = run DRG
 
     // --- 7) Apply all changes ---
@@ -317,18 +409,7 @@ dds_status_t AD9910::dds_freq_single(   uint8_t profile_index,
 
 template<typename Profile>
 dds_status_t AD9910::set_profile(){
-    dds_status_t s;
-    const uint8_t profile_index = Profile::index;
-    const uint8_t bits = profile_index & 0x07;
-    auto setp = [this](DdsPin pin, bool high) {
-        return pin_write(idx(pin),
-                         high ? HWAbstraction::HW_PIN_HIGH
-                              : HWAbstraction::HW_PIN_LOW); };
-
-    if ((s = setp(DdsPin::PROFILE0, (bits & 0x01) != 0)) != dds_status_t::DDS_OK) return s;
-    if ((s = setp(DdsPin::PROFILE1, (bits & 0x02) != 0)) != dds_status_t::DDS_OK) return s;
-    if ((s = setp(DdsPin::PROFILE2, (bits & 0x04) != 0)) != dds_status_t::DDS_OK) return s;
-    return dds_status_t::DDS_OK;
+    return dds_profile_select(Profile::index & 0x07);
 }
 
 
@@ -348,12 +429,10 @@ dds_status_t AD9910::dds_freq_out(uint32_t f_out, int16_t ampl_db){
     // 4. calculate amplitude conversion -> asf
     const uint16_t asf = calc_ampl_scale_factor(ampl_db);
 
-    auto r = PROFILE::single_tone(ftw,0,asf);
-    auto b = PROFILE::bytes();
-    TRY_OK( dds_reg_write(PROFILE::address, b.data(), b.size()) ,s,s);
-    TRY_OK( dds_update_io_pulse()  ,s,s);
-    TRY_OK( set_profile<PROFILE>() ,s,s);
-    TRY_OK( dds_update_io_pulse()  ,s,s);
+    // The pins switch the profile at once: one IO_UPDATE for the new contents, then the pins
+    Transaction t(*this);
+    t.write<Profile>(Profile::single_tone(ftw,0,asf)).select(Profile::index & 0x07);
+    TRY_OK( t.commit() ,s,s);
     return s;
 }
 
@@ -372,55 +451,246 @@ dds_status_t AD9910::dds_digital_ramp(  uint32_t ftw_start,
     if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
     dds_status_t s = dds_status_t::DDS_OK;
 
+    RegisterBatch b;
+
     // 1) Program PROFILE0 amplitude (ASF)
     uint16_t asf = calc_ampl_scale_factor(0);   //Amplitude_dB=0
-
-    auto r = ad9910_reg::PROFILE0::single_tone(0,0,asf); 
-    auto b = ad9910_reg::PROFILE0::bytes();
-    TRY_OK( dds_reg_write(ad9910_reg::PROFILE0::address, b.data(), b.size()) ,s,s)
+    b.add<ad9910_reg::PROFILE0>(ad9910_reg::PROFILE0::single_tone(0,0,asf));
 
     // Select profile 0 on the pins (OG: PROFILE0/1/2 = 0)
-    TRY_OK( pin_write(idx(DdsPin::PROFILE0), HWAbstraction::HW_PIN_LOW),    s, s);
-    TRY_OK( pin_write(idx(DdsPin::PROFILE1), HWAbstraction::HW_PIN_LOW),    s, s);
-    TRY_OK( pin_write(idx(DdsPin::PROFILE2), HWAbstraction::HW_PIN_LOW),    s, s);
+    TRY_OK( dds_profile_select(0),    s, s);
 
     // 2) CFR1: autoclear digital ramp accumulator, SDIO input-only
-    TRY_OK( dds_cfr1_drg_setup() ,s,s);                                              
-
-    // 3) DR_LIMIT: upper = ftw_end, lower = ftw_start 
-    TRY_OK( dds_drg_set_limit(ftw_start, ftw_end) ,s,s);
+    b.add(ad9910_reg::fixed::CFR1_DRG_SETUP);
 
-    // 4) DR_STEP: neg = ftw_step, pos = ftw_step (8 bytes)
-    TRY_OK( dds_drg_set_step(ftw_step) ,s,s);                                            
-
-    // 5) DR_RATE: neg = step_rate, pos = step_rate (4 bytes)
-    TRY_OK( dds_drg_set_rate(step_rate) ,s,s);
+    // 3..5) DR_LIMIT (upper = ftw_end, lower = ftw_start), DR_STEP, DR_RATE (neg = pos)
+    dds_drg_batch_range(b, ftw_start, ftw_end, ftw_step, step_rate);
 
     // 6) CFR2: enable DRG on frequency destination
-    TRY_OK( dds_drg_enable_freq(drg_continuous_) ,s,s);
+    drg_continuous_ = continuous;
+    b.add(drg_continuous_ ? ad9910_reg::fixed::CFR2_DRG_FREQ_CONT : ad9910_reg::fixed::CFR2_DRG_FREQ);
+    TRY_OK( dds_reg_flush(b) ,s,s);                                 // one CS assertion for all six
 
     // 7) DRCTL high (start DRG), IO_UPDATE
-    TRY_OK( hw_.hw_pin_mode(idx(DdsPin::DRCTL), pin_mode_t::PIN_OUTPUT), s,s);
+    TRY_OK( from_hw(hw_.hw_pin_mode(pin_indices_[idx(DdsPin::DRCTL)], PIN_OUTPUT)), s,s);
+    TRY_OK( pin_write(idx(DdsPin::DRCTL), HWAbstraction::HW_PIN_HIGH) ,s,s);
+    return dds_update_io_pulse();
+}
+
+// Same register sequence as dds_digital_ramp, with each slope solved on its own and the
+// no-dwell bits taken from the caller. Rise uses DR_STEP inc / DR_RATE pos, fall dec / neg.
+dds_status_t AD9910::dds_drg_ramp(const drg_ramp_t& ramp, uint32_t carrier_ftw, drg_ramp_t* achieved) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    const uint8_t  shift = ad9910_reg::CFR2::drg_shift(ramp.dest);
+    const uint32_t full  = 0xFFFFFFFFu >> shift;                    // destination word width
+    if (ramp.upper <= ramp.lower || ramp.upper > full) return dds_status_t::DDS_INVALID_PARAM;
+    const uint64_t sysclk = dds_sysclk_hz();
+    if (sysclk == 0) return dds_status_t::DDS_NOT_INITIALIZED;
+
+    const uint32_t acc_lo = ramp.lower << shift;
+    const uint32_t acc_hi = ramp.upper << shift;
+    uint32_t step_up = 1, step_down = 1;
+    uint16_t rate_up = 1, rate_down = 1;
+    const uint64_t ticks_up   = ad9910_math::drg_fit(acc_hi - acc_lo, ad9910_math::drg_ticks_from_ns(ramp.rise_ns, sysclk),
+                                                     step_up, rate_up);
+    const uint64_t ticks_down = ad9910_math::drg_fit(acc_hi - acc_lo, ad9910_math::drg_ticks_from_ns(ramp.fall_ns, sysclk),
+                                                     step_down, rate_down);
+
+    dds_status_t s = dds_status_t::DDS_OK;
+    RegisterBatch b;
+    if (ramp.dest != DrgDest::Frequency)
+        b.add<ad9910_reg::PROFILE0>(ad9910_reg::PROFILE0::single_tone(carrier_ftw, 0, calc_ampl_scale_factor(0)));
+    b.add(ad9910_reg::fixed::CFR1_DRG_SETUP);
+    dds_drg_batch_range(b, acc_lo, acc_hi, step_up, step_down, rate_up, rate_down);
+    drg_continuous_ = ramp.nodwell_high && ramp.nodwell_low;
+    b.add<ad9910_reg::CFR2>(ad9910_reg::CFR2::drg_enable(ramp.dest, ramp.nodwell_high, ramp.nodwell_low));
+    TRY_OK( dds_reg_flush(b) ,s,s);                                 // one CS assertion
+
+    TRY_OK( dds_profile_select(0) ,s,s);
+    TRY_OK( pin_write(idx(DdsPin::DRCTL), ramp.start_up ? HWAbstraction::HW_PIN_HIGH
+                                                        : HWAbstraction::HW_PIN_LOW) ,s,s);
+    TRY_OK( dds_update_io_pulse() ,s,s);
+
+    if (achieved) {
+        *achieved         = ramp;
+        achieved->rise_ns = ad9910_math::drg_ns_from_ticks(ticks_up,   sysclk);
+        achieved->fall_ns = ad9910_math::drg_ns_from_ticks(ticks_down, sysclk);
+    }
+    return s;
+}
+
+dds_status_t AD9910::dds_freq_ramp(const freq_ramp_t& ramp, freq_ramp_t* achieved) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    if (ramp.low_hz == 0 || ramp.high_hz <= ramp.low_hz) return dds_status_t::DDS_INVALID_PARAM;
+
+    const drg_ramp_t r = { DrgDest::Frequency, dds_freq_ftw(ramp.low_hz), dds_freq_ftw(ramp.high_hz),
+                           ramp.rise_ns, ramp.fall_ns, ramp.nodwell_high, ramp.nodwell_low, ramp.start_up };
+    drg_ramp_t got;
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( dds_drg_ramp(r, 0, &got) ,s,s);
+    if (achieved) {
+        *achieved         = ramp;
+        achieved->rise_ns = got.rise_ns;
+        achieved->fall_ns = got.fall_ns;
+    }
+    return s;
+}
+
+dds_status_t AD9910::dds_phase_ramp(uint32_t carrier_hz, uint32_t from_cdeg, uint32_t to_cdeg,
+                                    uint64_t rise_ns, uint64_t fall_ns, bool continuous) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    const drg_ramp_t r = { DrgDest::Phase, ad9910_math::pow_from_cdeg(from_cdeg), ad9910_math::pow_from_cdeg(to_cdeg),
+                           rise_ns, fall_ns, continuous, continuous, true };
+    return dds_drg_ramp(r, dds_freq_ftw(carrier_hz));
+}
+
+dds_status_t AD9910::dds_ampl_ramp(uint32_t carrier_hz, int32_t low_cdb, int32_t high_cdb,
+                                   uint64_t rise_ns, uint64_t fall_ns, bool continuous) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    const drg_ramp_t r = { DrgDest::Amplitude, ad9910_math::asf_from_cdb(low_cdb), ad9910_math::asf_from_cdb(high_cdb),
+                           rise_ns, fall_ns, continuous, continuous, true };
+    return dds_drg_ramp(r, dds_freq_ftw(carrier_hz));
+}
+
+// Without AUTOCLR_DRG_ACC (CFR1 defaults) the accumulator survives IO_UPDATE, so each segment
+// starts where the previous one stopped. Limits lower = upper = ftw_start with a full-scale
+// step pin the output there whatever the accumulator held before.
+dds_status_t AD9910::dds_drg_chirp_begin(uint32_t ftw_start) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    RegisterBatch b;
+    b.add(ad9910_reg::fixed::CFR1_DEFAULTS);
+    b.add<ad9910_reg::DR_LIMIT>(ad9910_reg::DR_LIMIT::set_limit(ftw_start, ftw_start));
+    b.add<ad9910_reg::DR_STEP >(ad9910_reg::DR_STEP::set_step(0xFFFFFFFFu, 0xFFFFFFFFu));
+    b.add<ad9910_reg::DR_RATE >(ad9910_reg::DR_RATE::set_rate(1, 1));
+    drg_continuous_ = false;
+    b.add(ad9910_reg::fixed::CFR2_DRG_FREQ);                        // dwell at the limits
+    TRY_OK( dds_reg_flush(b) ,s,s);
+
+    TRY_OK( dds_profile_select(0) ,s,s);
     TRY_OK( pin_write(idx(DdsPin::DRCTL), HWAbstraction::HW_PIN_HIGH) ,s,s);
     return dds_update_io_pulse();
 }
 
+// New limits go active first, then DRCTL picks the direction: the accumulator sits on the
+// start limit until then, so a direction change never runs on the old limits
+dds_status_t AD9910::dds_drg_chirp_segment(const uint8_t* frames, size_t len, bool up) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    if (!frames)           return dds_status_t::DDS_INVALID_PARAM;
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    RegisterBatch b;
+    for (size_t pos = 0; pos < len; ) {
+        const uint8_t n = static_cast<uint8_t>(ad9910_reg::reg_len(frames[pos] & 0x7Fu) + 1u);
+        if (n == 1 || pos + n > len || !b.add_frame(frames + pos, n)) return dds_status_t::DDS_INVALID_PARAM;
+        pos += n;
+    }
+    TRY_OK( dds_reg_flush(b)        ,s,s);      // unchanged DR_STEP / DR_RATE are skipped
+    TRY_OK( dds_update_io_pulse()   ,s,s);
+    return pin_write(idx(DdsPin::DRCTL), up ? HWAbstraction::HW_PIN_HIGH : HWAbstraction::HW_PIN_LOW);
+}
+
+dds_status_t AD9910::dds_drover(bool* over) {
+    if (!over) return dds_status_t::DDS_INVALID_PARAM;
+    HWAbstraction::hw_pin_value_t v = HWAbstraction::HW_PIN_LOW;
+    const dds_status_t s = pin_read(idx(DdsPin::DROVER), &v);
+    *over = (v == HWAbstraction::HW_PIN_HIGH);
+    return s;
+}
+
+uint16_t AD9910::dds_ampl_asf(int16_t ampl_db) { return calc_ampl_scale_factor(ampl_db); }
+
+dds_status_t AD9910::dds_profile_load(uint8_t index, uint32_t ftw, uint16_t pow, uint16_t asf, bool io_update) {
+    // All eight profiles share PROFILE0's layout, only the address differs
+    const auto b = ad9910_reg::PROFILE0::bytes(ad9910_reg::PROFILE0::single_tone(ftw, pow, asf));
+    return dds_profile_load_raw(index, b.data(), io_update);
+}
+
+dds_status_t AD9910::dds_profile_load_raw(uint8_t index, const uint8_t* payload, bool io_update) {
+    if (!is_initialized())      return dds_status_t::DDS_NOT_INITIALIZED;
+    if (index > 7 || !payload)  return dds_status_t::DDS_INVALID_PARAM;
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    constexpr size_t len = ad9910_reg::PROFILE0::length;
+    TRY_OK( dds_reg_write(static_cast<uint8_t>(ad9910_reg::PROFILE0::address + index), payload, len) ,s,s);
+    if (io_update) TRY_OK( dds_update_io_pulse() ,s,s);
+    return s;
+}
+
 // ✅ Checked 
 dds_status_t AD9910::dds_restart_drg() {
     if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
-    dds_status_t s = dds_drg_enable_freq(false); // disable continuous mode
+    dds_status_t s = dds_cfr2_drg_freq_enable(false); // disable continuous mode
     if (s != dds_status_t::DDS_OK) return s;
     return dds_update_io_pulse();
 }
 
-// ✅ Checked 
+// The pin idles low (setup sequence), the rising edge latches. The datasheet wants the high
+// time above one SYNC_CLK (~4 ns at 1 GHz): a 16 MHz AVR's two pin writes already take that
+// long, a fast Cortex-M GPIO may not, nor may slow level shifters / long wires. Hence the
+// context's 10 us default; 0 only where the pin writes are known to be slow enough.
 dds_status_t AD9910::dds_update_io_pulse() {
+    if (io_internal_) return dds_status_t::DDS_OK;                  // the chip's own timer latches
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( pin_write(idx(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_HIGH)  ,s,s);
+    if (ad9910_ctx_.io_update_pulse_us) hw().hw_delay_us(ad9910_ctx_.io_update_pulse_us);
+    TRY_OK( pin_write(idx(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_LOW)   ,s,s);
+    return s;
+}
+
+// ----------------------------------------
+//           INTERNAL I/O UPDATE
+// ----------------------------------------
+void AD9910::cfr2_io_overlay(uint8_t* payload) const {
+    using ad9910_reg::CFR2;
+    const auto v = CFR2::io_update_internal(true, io_rate_ctrl_, CFR2::value_type(unpack_be(payload, CFR2::length)));
+    const auto b = CFR2::bytes(v);
+    memcpy(payload, b.data(), b.size());
+}
+
+// The CFR2 switch itself needs one last external pulse. Right after its rising edge the chip
+// owns the line, so the MCU pin goes straight to input instead of driving it low again.
+dds_status_t AD9910::dds_io_update_internal(uint64_t period_ns, uint64_t* achieved_ns) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    const uint64_t sysclk = dds_sysclk_hz();
+    if (sysclk == 0) return dds_status_t::DDS_NOT_INITIALIZED;
+    uint8_t  a = 0;
+    uint32_t b = 0;
+    const uint64_t ticks = ad9910_math::io_update_fit(ad9910_math::drg_ticks_from_ns(period_ns, sysclk), a, b);
+    if (ticks == 0) return dds_status_t::DDS_INVALID_PARAM;
+    const uint64_t ns = ad9910_math::drg_ns_from_ticks(ticks, sysclk);
     dds_status_t s = dds_status_t::DDS_OK;
-    TRY_OK( pin_write(idx(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_LOW)       ,s,s);
-    hw().hw_delay_us(10);
-    TRY_OK(     pin_write(idx(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_HIGH)  ,s,s);
-    hw().hw_delay_us(10);
-    TRY_OK( pin_write(idx(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_LOW)       ,s,s);
+
+    RegisterBatch batch;
+    batch.add<ad9910_reg::IO_UPDATE_RATE>(ad9910_reg::IO_UPDATE_RATE::set_rate(b));
+    batch.add<ad9910_reg::CFR2>(ad9910_reg::CFR2::io_update_internal(true, a, regs_.cfr2));
+    io_rate_ctrl_ = a;                                              // overlay uses it if already running
+    TRY_OK( dds_reg_flush(batch) ,s,s);
+    if (!io_internal_) {
+        TRY_OK( pin_write(idx(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_HIGH) ,s,s);
+        TRY_OK( from_hw(hw_.hw_pin_mode(pin_indices_[idx(DdsPin::IO_UPDATE)], PIN_INPUT)) ,s,s);
+        io_internal_ = true;
+    }
+    io_period_us_ = (ns + 999u) / 1000u;
+    if (achieved_ns) *achieved_ns = ns;
+    return s;
+}
+
+// Cleared bit goes active on the next internal tick, only then is the pin ours again.
+// Until the CFR2 write went out the chip still runs its timer, so the mode stays internal.
+dds_status_t AD9910::dds_io_update_external() {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    if (!io_internal_)     return dds_status_t::DDS_OK;
+    io_internal_ = false;                                           // or the CFR2 overlay puts the bits back
+    dds_status_t s = dds_reg_commit<ad9910_reg::CFR2>(regs_.cfr2, ad9910_reg::CFR2::io_update_internal(false, 0, regs_.cfr2));
+    if (s != dds_status_t::DDS_OK) { io_internal_ = true; return s; }
+    const uint64_t wait_us = io_period_us_ + 1u;                    // may exceed 2^32 at a low SYSCLK
+    const uint64_t wait_ms = wait_us / 1000u;
+    hw().hw_delay_ms(wait_ms > 0xFFFFFFFFu ? 0xFFFFFFFFu : static_cast<uint32_t>(wait_ms));
+    hw().hw_delay_us(static_cast<uint32_t>(wait_us % 1000u));
+    TRY_OK( pin_write(idx(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_LOW) ,s,s);
+    TRY_OK( from_hw(hw_.hw_pin_mode(pin_indices_[idx(DdsPin::IO_UPDATE)], PIN_OUTPUT)) ,s,s);
     return s;
 }
 
@@ -444,98 +714,20 @@ dds_status_t AD9910::dds_update_io_pulse() {
 
 
 // NOT SURE NEEDED 
-void AD9910::calc_best_step_rate(uint16_t& step,
-                                 uint64_t& step_rate,
-                                 uint32_t f_mod_hz) const{
-    // Guard invalid inputs
-    const uint64_t sysclk = dds_sysclk_hz();
-    if (step == 0 || f_mod_hz == 0 || sysclk == 0) {
-        step_rate = 0; step = 0; return; }
-
-    // ---- OG formula, directly matched ----
-    // T_step      = 1 / (F_mod * Step)
-    // fStep_Rate  = (T_step * sysclk) / 4
-    // Step_Rate   = ceil(fStep_Rate)
-    // Step        = (sysclk) / (4 * Step_Rate * F_mod)
-    // ---------------------------------------
-
-    long double t_step =
-        1.0L / (static_cast<long double>(f_mod_hz) *
-                static_cast<long double>(step));
-
-    long double f_step_rate = (t_step * static_cast<long double>(sysclk)) / 4.0L;
-
-    // ceil() like OG
-    step_rate = static_cast<uint64_t>(std::ceil(f_step_rate));
-
-    if (step_rate == 0) { step = 0; return;}
-
-    long double eff_step =
-        static_cast<long double>(sysclk) /
-        (4.0L * static_cast<long double>(step_rate) *
-               static_cast<long double>(f_mod_hz));
-
-    // Clamp to uint16_t range
-    if (eff_step <= 0.0L) {
-        step = 0;
-    } else if (eff_step > 65535.0L) {
-        step = 65535;
-    } else {
-        step = static_cast<uint16_t>(eff_step);
-    }
-}
-
-// Another verion
 bool AD9910::calc_best_step_rate(uint16_t& step,
                                  uint64_t& step_rate,
                                  uint32_t f_mod_hz) const
 {
-    const uint64_t sysclk = dds_sysclk_hz();
-    if (step == 0 || f_mod_hz == 0 || sysclk == 0) {
-        step_rate = 0;
-        step      = 0;
-        return false;
-    }
-
-    // T_step = 1 / (F_mod * Step)
-    const double t_step =
-        1.0 / (static_cast<double>(f_mod_hz) *
-               static_cast<double>(step));
-
-    // fStep_Rate = (T_step * sysclk) / 4
-    const double f_step_rate =
-        (t_step * static_cast<double>(sysclk)) / 4.0;
-
-    if (f_step_rate <= 0.0) {
-        step_rate = 0;
-        step      = 0;
-        return false;
-    }
-
-    step_rate = static_cast<uint64_t>(std::ceil(f_step_rate));
-
-    // if HW step_rate is e.g. 16-bit, clamp here:
-    // if (step_rate > 0xFFFFu) step_rate = 0xFFFFu;
-
-    // Step = sysclk / (4 * Step_Rate * F_mod)
-    const double eff_step =
-        static_cast<double>(sysclk) /
-        (4.0 * static_cast<double>(step_rate) *
-               static_cast<double>(f_mod_hz));
-
-    if (eff_step <= 0.0) {
-        step_rate = 0;
-        step      = 0;
-        return false;
-    }
-
-    double s = eff_step;
-    if (s > 65535.0) s = 65535.0;
-    step = static_cast<uint16_t>(s);
-
-    return true;
+    return ad9910_math::best_step_rate(dds_sysclk_hz(), f_mod_hz, step, step_rate);
 }
 
 
-
-
+// Explicit instantiations: the profile templates live in this translation unit
+template dds_status_t AD9910::dds_freq_out<ad9910_reg::PROFILE0>(uint32_t, int16_t);
+template dds_status_t AD9910::dds_freq_out<ad9910_reg::PROFILE1>(uint32_t, int16_t);
+template dds_status_t AD9910::dds_freq_out<ad9910_reg::PROFILE2>(uint32_t, int16_t);
+template dds_status_t AD9910::dds_freq_out<ad9910_reg::PROFILE3>(uint32_t, int16_t);
+template dds_status_t AD9910::dds_freq_out<ad9910_reg::PROFILE4>(uint32_t, int16_t);
+template dds_status_t AD9910::dds_freq_out<ad9910_reg::PROFILE5>(uint32_t, int16_t);
+template dds_status_t AD9910::dds_freq_out<ad9910_reg::PROFILE6>(uint32_t, int16_t);
+template dds_status_t AD9910::dds_freq_out<ad9910_reg::PROFILE7>(uint32_t, int16_t);
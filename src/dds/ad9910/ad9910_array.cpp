@@ -0,0 +1,182 @@
+# include "dds/ad9910/ad9910_array.h"
+# include "dds/ad9910/ad9910_registers.h"
+
+
+// ----------------------------------------
+//               CHANNELS
+// ----------------------------------------
+DdsArray::DdsArray(HWAbstraction& hw,
+                   const HWAbstraction::spi_config_t& spi_cfg,
+                   const AD9910Context& ctx,
+                   const pin_t* cs_pins,
+                   uint8_t n,
+                   const std::array<pin_t, kPinCount>& shared)
+{
+    if (!cs_pins || n == 0 || n > MAX_CHANNELS) return;
+    pins_.reserve(n);
+    chips_.reserve(n);
+    for (uint8_t i = 0; i < n; ++i) {
+        pins_.push_back(dds_pins_with_cs(shared, cs_pins[i]));
+        chips_.emplace_back(hw, spi_cfg, ctx, pins_.back());
+    }
+}
+
+// Same scan as AD9910::dds_attach_hook does for PROFILE[2:0]
+void DdsArray::group_cs_ports() {
+    cs_port_count_ = 0;
+    cs_port_t groups[MAX_CHANNELS] = {};
+    uint8_t n = 0;
+    for (const auto& c : chips_) {
+        uint8_t port; uint32_t mask;
+        if (!c.hw_.hw_pin_port(c.pin_indices_[idx(DdsPin::SPI_CS)], &port, &mask))
+            return;                                         // no port access: sequential writes
+        uint8_t g = 0;
+        while (g < n && groups[g].port != port) ++g;
+        if (g == n) groups[n++].port = port;
+        groups[g].mask |= mask;
+    }
+    for (uint8_t g = 0; g < n; ++g) cs_ports_[g] = groups[g];
+    cs_port_count_ = n;
+}
+
+// CS active low: every group written even after an error, so release always completes
+dds_status_t DdsArray::select_all(bool selected) {
+    HWAbstraction& hw = chips_[0].hw_;
+    dds_status_t s = dds_status_t::DDS_OK;
+    for (uint8_t g = 0; g < cs_port_count_; ++g) {
+        const cs_port_t& p = cs_ports_[g];
+        const dds_status_t r = AD9910::from_hw(hw.hw_port_write_masked(p.port, p.mask, selected ? 0u : p.mask));
+        if (s == dds_status_t::DDS_OK) s = r;
+    }
+    return s;
+}
+
+
+// ----------------------------------------
+//                 INIT
+// ----------------------------------------
+dds_status_t DdsArray::init() {
+    if (chips_.empty()) return dds_status_t::DDS_INVALID_PARAM;
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    // 1) Every channel's pins, each CS high before the shared lines move
+    for (auto& c : chips_) {
+        c.set_initialized(false);
+        TRY_OK( c.dds_validate_context()                                        ,s,s);
+        TRY_OK( c.dds_attach_board(c.pins_, c.pins_count_)                      ,s,s);
+        TRY_OK( c.pin_write(idx(DdsPin::SPI_CS), HWAbstraction::HW_PIN_HIGH)    ,s,s);
+    }
+    group_cs_ports();
+
+    // 2) One set-up sequence on the shared lines resets every chip, one SPI set-up
+    TRY_OK( chips_[0].dds_setup_pins() ,s,s);
+    TRY_OK( chips_[0].spi_init()       ,s,s);
+    for (auto& c : chips_) {
+        c.reg_cache_.invalidate_all();
+        c.regs_ = ad9910_reg::RegisterBank::power_on();
+    }
+
+    // 3) Same context, same set-up frames: sent once, latched together
+    RegisterBatch b;
+    chips_[0].dds_setup_batch(b);
+    TRY_OK( broadcast(b) ,s,s);
+    TRY_OK( io_update()  ,s,s);
+    for (auto& c : chips_) c.set_initialized(true);
+    return s;
+}
+
+
+// ----------------------------------------
+//               BROADCAST
+// ----------------------------------------
+dds_status_t DdsArray::broadcast(RegisterBatch& batch) {
+    if (chips_.empty())   { batch.clear(); return dds_status_t::DDS_INVALID_PARAM; }
+    if (batch.overflow()) { batch.clear(); return dds_status_t::DDS_INVALID_PARAM; }
+    if (cs_port_count_ == 0) return broadcast_each(batch);
+
+    // 1) Drop what every channel already holds
+    batch.drop_if([this](uint8_t addr, const uint8_t* p, uint8_t len) {
+        for (const auto& c : chips_)
+            if (!c.reg_cache_.matches(addr, p, len)) return false;
+        return true; });
+    if (batch.empty()) return dds_status_t::DDS_OK;
+
+    // 2) Unknown content on every channel until the burst completes
+    for (auto& c : chips_)
+        for (uint8_t i = 0; i < batch.count(); i++) c.reg_cache_.invalidate(batch.entry(i).addr);
+
+    // 3) All CS low, the frames once, all CS high (each a single write when they share a port)
+    dds_status_t s = select_all(true);
+    if (s == dds_status_t::DDS_OK) s = chips_[0].spi_tx(batch.data(), batch.size());
+    const dds_status_t r = select_all(false);                   // always release CS
+    if (s == dds_status_t::DDS_OK) s = r;
+
+    if (s == dds_status_t::DDS_OK) {
+        for (auto& c : chips_) {
+            for (uint8_t i = 0; i < batch.count(); i++) {
+                const auto& e = batch.entry(i);
+                c.reg_cache_.store(e.addr, batch.payload(i), e.len);
+                c.regs_.store(e.addr, unpack_be(batch.payload(i), e.len));
+            }
+        }
+    }
+    batch.clear();
+    return s;
+}
+
+// CS lines can't be pulled together: the same frames, one channel after the other
+dds_status_t DdsArray::broadcast_each(RegisterBatch& batch) {
+    dds_status_t s = dds_status_t::DDS_OK;
+    for (auto& c : chips_) {
+        RegisterBatch b = batch;                            // flush clears its batch
+        s = c.dds_reg_flush(b);
+        if (s != dds_status_t::DDS_OK) break;
+    }
+    batch.clear();
+    return s;
+}
+
+dds_status_t DdsArray::io_update() {
+    if (chips_.empty()) return dds_status_t::DDS_INVALID_PARAM;
+    return chips_[0].dds_update_io_pulse();
+}
+
+
+// ----------------------------------------
+//             MULTICHIP SYNC
+// ----------------------------------------
+dds_status_t DdsArray::sync(uint8_t gen_delay, const uint8_t* rx_delay, uint8_t preset) {
+    using MS = ad9910_reg::MULTICHIP_SYNC;
+    if (chips_.empty() || !chips_[0].is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    // Receivers everywhere (one transfer when the delays match), then the generator on channel 0
+    if (!rx_delay) TRY_OK( broadcast<MS>(MS::sync(false, 0, 0, preset)) ,s,s);
+    for (uint8_t i = 0; i < size(); ++i) {
+        if (!rx_delay && i != 0) continue;
+        const auto f = MS::frame(MS::sync(i == 0, gen_delay, rx_delay ? rx_delay[i] : 0u, preset));
+        TRY_OK( chips_[i].dds_reg_write_frame(f.data(), f.size()) ,s,s);
+    }
+    TRY_OK( io_update()     ,s,s);
+    TRY_OK( phase_restart() ,s,s);
+    return s;
+}
+
+// Every phase accumulator held at 0, then released on one IO_UPDATE edge
+dds_status_t DdsArray::phase_restart() {
+    using CFR1 = ad9910_reg::CFR1;
+    dds_status_t s = dds_status_t::DDS_OK;
+    bool same = true;
+    for (const auto& c : chips_) same = same && c.regs_.cfr1.val == chips_[0].regs_.cfr1.val;
+
+    for (const bool hold : { true, false }) {
+        if (same) {
+            TRY_OK( broadcast<CFR1>(CFR1::set<CFR1::CLR_PHASE_ACC>(hold, chips_[0].regs_.cfr1)) ,s,s);
+        } else {
+            for (auto& c : chips_)
+                TRY_OK( c.dds_reg_commit<CFR1>(c.regs_.cfr1, CFR1::set<CFR1::CLR_PHASE_ACC>(hold, c.regs_.cfr1)) ,s,s);
+        }
+        TRY_OK( io_update() ,s,s);
+    }
+    return s;
+}
@@ -0,0 +1,392 @@
+#include "dds/ad9910/ad9910_math.h"
+
+namespace ad9910_math {
+
+// ----------------------------------------
+//               128-BIT
+// ----------------------------------------
+u128_t mul_u64(uint64_t a, uint64_t b) {
+    const uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    const uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    const uint64_t ll = a_lo * b_lo;
+    const uint64_t lh = a_lo * b_hi;
+    const uint64_t hl = a_hi * b_lo;
+    const uint64_t hh = a_hi * b_hi;
+    const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    return { hh + (lh >> 32) + (hl >> 32) + (mid >> 32),
+             (mid << 32) | (ll & 0xFFFFFFFFu) };
+}
+
+bool less(u128_t a, u128_t b) {
+    return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+}
+
+uint64_t div_u128(u128_t n, uint64_t d, uint64_t* rem) {
+    if (n.hi == 0) {                                // common case: native 64-bit division
+        if (rem) *rem = n.lo % d;
+        return n.lo / d;
+    }
+    if (n.hi >= d) {                                // quotient ≥ 2^64
+        if (rem) *rem = 0;
+        return UINT64_MAX;
+    }
+    // Restoring division, remainder starts with the high word (< d)
+    uint64_t r = n.hi, lo = n.lo, q = 0;
+    for (uint8_t i = 0; i < 64; i++) {
+        const bool carry = (r >> 63) != 0;
+        r  = (r << 1) | (lo >> 63);
+        lo <<= 1;
+        q <<= 1;
+        if (carry || r >= d) { r -= d; q |= 1u; }
+    }
+    if (rem) *rem = r;
+    return q;
+}
+
+uint64_t div_round_u128(u128_t n, uint64_t d) {
+    uint64_t r = 0;
+    const uint64_t q = div_u128(n, d, &r);
+    if (q == UINT64_MAX) return q;
+    return (r >= d - r) ? q + 1u : q;               // 2r ≥ d without overflowing
+}
+
+
+// ----------------------------------------
+//               FREQUENCY
+// ----------------------------------------
+uint32_t ftw_from_hz(uint32_t freq_hz, uint32_t sysclk_hz) {
+    if (sysclk_hz == 0 || freq_hz == 0) return 0;
+    if (freq_hz >= sysclk_hz) return 0xFFFFFFFFu;   // ideal FTW ≥ 2^32 → saturate
+    const uint64_t numerator = (uint64_t)freq_hz << 32;
+    return static_cast<uint32_t>((numerator + (sysclk_hz / 2u)) / sysclk_hz);
+}
+
+
+ftw_recip_t ftw_recip(uint32_t sysclk_hz) {
+    ftw_recip_t rc{0, 0, sysclk_hz};
+    if (sysclk_hz == 0 || sysclk_hz >= (1ul << 30)) return rc;
+
+    // k = bit length of 2·sysclk² - 1, i.e. the smallest k with 2^k ≥ 2·sysclk²
+    const uint64_t two_s2 = 2ull * sysclk_hz * sysclk_hz;
+    uint8_t k = 0;
+    while (k < 63 && (uint64_t(1) << k) < two_s2) k++;
+
+    // R = ceil(2^(32+k) / sysclk), 32 + k ≤ 93
+    const uint8_t  e = uint8_t(32u + k);
+    const u128_t   num = (e >= 64) ? u128_t{ uint64_t(1) << (e - 64), 0 } : u128_t{ 0, uint64_t(1) << e };
+    uint64_t rem = 0;
+    const uint64_t q = div_u128(num, sysclk_hz, &rem);
+    if (q == UINT64_MAX) return rc;
+    rc.r     = q + (rem ? 1u : 0u);
+    rc.shift = k;
+    return rc;
+}
+
+// f (32 bits) × R (64 bits) + 2^(k-1), then >> k. The product is 96 bits: two 32×32 multiplies.
+static inline uint32_t ftw_mul_shift(uint32_t f, uint64_t r, uint8_t k) {
+    const uint64_t lo  = uint64_t(f) * (r & 0xFFFFFFFFu);
+    const uint64_t mid = uint64_t(f) * (r >> 32) + (lo >> 32);
+    u128_t p = { mid >> 32, (mid << 32) | (lo & 0xFFFFFFFFu) };
+    const uint64_t half = uint64_t(1) << (k - 1u);
+    p.lo += half;
+    if (p.lo < half) p.hi++;
+    return static_cast<uint32_t>((p.hi << (64u - k)) | (p.lo >> k));
+}
+
+uint32_t ftw_from_hz(uint32_t freq_hz, const ftw_recip_t& rc) {
+    if (rc.r == 0) return ftw_from_hz(freq_hz, rc.sysclk_hz);
+    if (freq_hz == 0) return 0;
+    if (freq_hz >= rc.sysclk_hz) return 0xFFFFFFFFu;
+    return ftw_mul_shift(freq_hz, rc.r, rc.shift);
+}
+
+void ftw_from_hz_batch(const uint32_t* freq_hz, uint32_t* ftw_out, size_t n, const ftw_recip_t& rc) {
+    if (!freq_hz || !ftw_out) return;
+    if (rc.r == 0) {
+        for (size_t i = 0; i < n; i++) ftw_out[i] = ftw_from_hz(freq_hz[i], rc.sysclk_hz);
+        return;
+    }
+    const uint64_t r = rc.r;                        // kept in registers across the loop
+    const uint8_t  k = rc.shift;
+    const uint32_t s = rc.sysclk_hz;
+    for (size_t i = ftw_batch_simd(freq_hz, ftw_out, n, rc); i < n; i++) {
+        const uint32_t f = freq_hz[i];
+        ftw_out[i] = (f == 0) ? 0u : (f >= s) ? 0xFFFFFFFFu : ftw_mul_shift(f, r, k);
+    }
+}
+
+
+// ----------------------------------------
+//               AMPLITUDE
+// ----------------------------------------
+// 10^((dB + 84.288) / 20) in 0.01 dB steps: z = cdB + 8428 → 10^0.0004 × 10^(z / 2000),
+// z = 2000·q + 100·a + b  →  10^q × COARSE[a] × FINE[b].
+// COARSE[a] = 10^((100·a + 0.8) / 2000) in Q28, FINE[b] = 10^(b / 2000) in Q31.
+// Exact floor over the whole domain (checked against a 60-digit reference when generated).
+namespace {
+    const uint32_t kAsfCoarseQ28[20] AD9910_PROGMEM = {
+         268682808u,  301467069u,  338251615u,  379524554u,  425833553u,
+         477793105u,  536092682u,  601505882u,  674900700u,  757251040u,
+         849649642u,  953322578u, 1069645525u, 1200162019u, 1346603933u,
+        1510914464u, 1695273911u, 1902128613u, 2134223406u, 2394638048u
+    };
+    const uint32_t kAsfFineQ31[100] AD9910_PROGMEM = {
+        2147483648u, 2149957454u, 2152434109u, 2154913617u, 2157395982u,
+        2159881206u, 2162369294u, 2164860247u, 2167354070u, 2169850765u,
+        2172350337u, 2174852788u, 2177358121u, 2179866341u, 2182377450u,
+        2184891452u, 2187408350u, 2189928147u, 2192450847u, 2194976453u,
+        2197504968u, 2200036396u, 2202570740u, 2205108004u, 2207648190u,
+        2210191303u, 2212737345u, 2215286320u, 2217838231u, 2220393082u,
+        2222950876u, 2225511617u, 2228075307u, 2230641951u, 2233211551u,
+        2235784112u, 2238359636u, 2240938126u, 2243519588u, 2246104022u,
+        2248691434u, 2251281827u, 2253875203u, 2256471567u, 2259070922u,
+        2261673272u, 2264278619u, 2266886967u, 2269498320u, 2272112681u,
+        2274730054u, 2277350442u, 2279973848u, 2282600277u, 2285229731u,
+        2287862214u, 2290497729u, 2293136281u, 2295777872u, 2298422506u,
+        2301070187u, 2303720917u, 2306374701u, 2309031542u, 2311691444u,
+        2314354410u, 2317020443u, 2319689548u, 2322361727u, 2325036984u,
+        2327715323u, 2330396748u, 2333081261u, 2335768867u, 2338459569u,
+        2341153371u, 2343850275u, 2346550287u, 2349253408u, 2351959644u,
+        2354668997u, 2357381471u, 2360097069u, 2362815796u, 2365537655u,
+        2368262649u, 2370990782u, 2373722058u, 2376456481u, 2379194053u,
+        2381934779u, 2384678662u, 2387425705u, 2390175914u, 2392929290u,
+        2395685838u, 2398445562u, 2401208464u, 2403974550u, 2406743821u
+    };
+    const uint16_t kPow10[5] = { 1u, 10u, 100u, 1000u, 10000u };
+
+    constexpr int32_t  kCdbOffset = 8428;           // 84.28 dB, the 0.008 dB rest is folded into COARSE
+    constexpr uint16_t kMaxAsf    = 0x3FFFu;
+}
+
+uint16_t asf_from_cdb(int32_t centi_db) {
+    if (centi_db >= 0) return kMaxAsf;
+    const int32_t z = centi_db + kCdbOffset;
+    if (z < 0) return 0;                            // below 1 LSB
+
+    const uint16_t q = static_cast<uint16_t>(z / 2000);
+    const uint16_t r = static_cast<uint16_t>(z % 2000);
+    const uint64_t c = AD9910_PGM_READ_U32(&kAsfCoarseQ28[r / 100u]);
+    const uint64_t f = AD9910_PGM_READ_U32(&kAsfFineQ31[r % 100u]);
+
+    const uint64_t v_q42 = ((c * f) >> 17) * kPow10[q];     // Q59 → Q42, ≤ 2^59
+    const uint64_t asf   = v_q42 >> 42;
+    return asf > kMaxAsf ? kMaxAsf : static_cast<uint16_t>(asf);
+}
+
+uint16_t asf_from_db(int16_t db) {
+    if (db <= -85) return 0;
+    if (db >= 0)   return kMaxAsf;
+    return asf_from_cdb(int32_t(db) * 100);
+}
+
+uint16_t pow_from_cdeg(uint32_t centi_deg) {
+    if (centi_deg >= 36000u) return 0xFFFFu;
+    return static_cast<uint16_t>((uint64_t(centi_deg) * 65536u + 18000u) / 36000u);   // < 65536 below 359.995°
+}
+
+
+// ----------------------------------------
+//               DIGITAL RAMP
+// ----------------------------------------
+// Ramp time at step 1 / rate 1 is base_ns = 4e9 × delta / sysclk. Everything is compared
+// scaled by sysclk: base = 4e9 × delta (fits 64 bits), want = desired_ns × sysclk (128 bits).
+bool drg_step_rate(uint32_t delta_ftw, uint64_t desired_ns, uint64_t sysclk_hz,
+                   uint32_t& ftw_step, uint16_t& step_rate) {
+    ftw_step  = 1u;
+    step_rate = 1u;
+    if (delta_ftw == 0 || desired_ns == 0 || sysclk_hz == 0) return false;
+
+    const uint64_t base = 4000000000ull * delta_ftw;
+    const u128_t   want = mul_u64(desired_ns, sysclk_hz);
+
+    if (less({0, base}, want)) {                    // too fast: slow the clock down
+        uint64_t sr = div_round_u128(want, base);
+        if (sr == 0)      sr = 1;
+        if (sr > 0xFFFFu) sr = 0xFFFFu;
+        step_rate = static_cast<uint16_t>(sr);
+    } else if (less(want, {0, base})) {             // too slow: bigger FTW steps
+        uint64_t fs = div_round_u128({0, base}, want.lo);
+        if (fs == 0)         fs = 1;
+        if (fs > delta_ftw)  fs = delta_ftw;
+        ftw_step = static_cast<uint32_t>(fs);
+    }
+    return true;
+}
+
+namespace {
+    struct drg_best_t {
+        uint64_t ticks;
+        uint64_t err;
+        uint32_t step;
+        uint16_t rate;
+    };
+
+    void drg_try(uint32_t delta, uint64_t want, uint64_t step, uint64_t rate, drg_best_t& best) {
+        if (step == 0 || rate == 0) return;
+        if (step > delta)  step = delta;
+        if (rate > 0xFFFFu) rate = 0xFFFFu;
+        const uint64_t t   = ((uint64_t(delta) + step - 1u) / step) * rate;
+        const uint64_t err = t > want ? t - want : want - t;
+        if (err < best.err) best = { t, err, static_cast<uint32_t>(step), static_cast<uint16_t>(rate) };
+    }
+}
+
+uint64_t drg_fit(uint32_t delta_ftw, uint64_t ticks, uint32_t& ftw_step, uint16_t& step_rate) {
+    ftw_step  = 1u;
+    step_rate = 1u;
+    if (delta_ftw == 0) return 0;
+    if (ticks == 0) ticks = 1;
+
+    constexpr uint32_t K = 64;      // candidates per family, ~400 evaluations
+    drg_best_t best = { 0, UINT64_MAX, 1u, 1u };
+    for (uint32_t r = 1; r <= K; ++r) {                         // fine rate, step follows
+        uint64_t n = (ticks + r / 2) / r;
+        if (n == 0) n = 1;
+        const uint64_t st = (n >= delta_ftw) ? 1u : (delta_ftw + n - 1u) / n;
+        drg_try(delta_ftw, ticks, st > 1 ? st - 1 : 1, r, best);
+        drg_try(delta_ftw, ticks, st,                  r, best);
+        drg_try(delta_ftw, ticks, st + 1,              r, best);
+    }
+    for (uint32_t st = 1; st <= K && st <= delta_ftw; ++st) {   // fine step, rate follows
+        const uint64_t n = (uint64_t(delta_ftw) + st - 1u) / st;
+        const uint64_t r = (ticks + n / 2) / n;
+        drg_try(delta_ftw, ticks, st, r > 1 ? r - 1 : 1, best);
+        drg_try(delta_ftw, ticks, st, r,                 best);
+        drg_try(delta_ftw, ticks, st, r + 1,             best);
+    }
+    ftw_step  = best.step;
+    step_rate = best.rate;
+    return best.ticks;
+}
+
+namespace {
+    uint32_t isqrt_u32(uint32_t x) {
+        uint32_t r = 0;
+        for (uint32_t bit = uint32_t(1) << 30; bit; bit >>= 2) {
+            if (x >= r + bit) { x -= r + bit; r = (r >> 1) + bit; }
+            else              { r >>= 1; }
+        }
+        return r;
+    }
+
+    struct solve_best_t { uint64_t err; uint32_t n; uint16_t r; };
+
+    void solve_try(uint32_t n, uint64_t r, uint64_t want, solve_best_t& best) {
+        if (r == 0) r = 1;
+        if (r > 0xFFFFu) r = 0xFFFFu;
+        const uint64_t t   = uint64_t(n) * r;
+        const uint64_t err = t > want ? t - want : want - t;
+        if (err < best.err) best = { err, n, static_cast<uint16_t>(r) };
+    }
+}
+
+bool drg_solve(uint32_t delta_ftw, uint64_t ticks, drg_solution_t& out) {
+    out = { 1u, 1u, 0u, 0u, 0u };
+    if (delta_ftw == 0) return false;
+    if (ticks == 0) ticks = 1;
+
+    const uint32_t S = isqrt_u32(delta_ftw);        // every n ≤ S is some ceil(delta / s)
+    solve_best_t best = { UINT64_MAX, 1u, 1u };
+
+    // Sparse step counts n > S: one per step size, best rate = floor / ceil of ticks / n
+    for (uint64_t st = 1; best.err != 0; ++st) {
+        const uint32_t n = static_cast<uint32_t>((delta_ftw + st - 1u) / st);
+        if (n <= S) break;
+        const uint64_t r = ticks / n;
+        solve_try(n, r,      ticks, best);
+        solve_try(n, r + 1u, ticks, best);
+    }
+
+    // Dense step counts n ≤ S: one per rate, best n = floor / ceil of ticks / rate
+    uint64_t r_lo = ticks / (uint64_t(S) + 1u);
+    uint64_t r_hi = ticks + 1u;
+    if (r_lo < 1u)     r_lo = 1u;
+    if (r_hi > 0xFFFFu) r_hi = 0xFFFFu;
+    if (r_lo > r_hi)    r_lo = r_hi;                // too long even at S steps: slowest rate
+    for (uint64_t r = r_lo; r <= r_hi && best.err != 0; ++r) {
+        const uint64_t n0 = ticks / r;
+        const uint64_t n1 = n0 + 1u;
+        if (n0 >= 1u) solve_try(static_cast<uint32_t>(n0 < S ? n0 : S), r, ticks, best);
+        solve_try(static_cast<uint32_t>(n1 < S ? n1 : S), r, ticks, best);
+    }
+
+    const uint32_t n  = best.n;
+    const uint32_t st = static_cast<uint32_t>((uint64_t(delta_ftw) + n - 1u) / n);
+    out.ftw_step  = st;
+    out.step_rate = best.r;
+    out.steps     = static_cast<uint32_t>((uint64_t(delta_ftw) + st - 1u) / st);
+    out.ticks     = uint64_t(out.steps) * best.r;
+    out.last_step = delta_ftw - (out.steps - 1u) * st;
+    return true;
+}
+
+uint64_t osk_fit(uint16_t asf, uint64_t ticks, uint8_t& step_code, uint16_t& rate) {
+    rate = 1u;
+    asf &= 0x3FFFu;
+    if (asf == 0) { step_code = 0; return 0; }
+
+    const uint8_t first = step_code <= 3u ? step_code : 0u;
+    const uint8_t last  = step_code <= 3u ? step_code : 3u;
+    uint64_t best_err = UINT64_MAX, best_ticks = 0;
+    for (uint8_t c = first; c <= last; ++c) {
+        const uint64_t n = (uint64_t(asf) + (1u << c) - 1u) >> c;
+        uint64_t r = (ticks + n / 2u) / n;
+        if (r < 1u)      r = 1u;
+        if (r > 0xFFFFu) r = 0xFFFFu;
+        const uint64_t t   = n * r;
+        const uint64_t err = t > ticks ? t - ticks : ticks - t;
+        if (err < best_err) {
+            best_err   = err;
+            best_ticks = t;
+            step_code  = c;
+            rate       = static_cast<uint16_t>(r);
+        }
+    }
+    return best_ticks;
+}
+
+uint64_t io_update_fit(uint64_t ticks, uint8_t& a, uint32_t& b) {
+    a = 0;
+    b = 0;
+    for (uint8_t c = 0; c <= 3u; ++c) {
+        const uint64_t n = (ticks + ((1ull << c) >> 1)) >> c;       // round(ticks / 2^c)
+        if (n > 0xFFFFFFFFull) continue;
+        if (n < 4u) return 0;
+        a = c;
+        b = static_cast<uint32_t>(n);
+        return n << c;
+    }
+    return 0;
+}
+
+uint8_t par_fm_gain(uint32_t span_ftw) {
+    uint8_t g = 0;
+    while (g < 15u && (span_ftw >> g) > 0xFFFFu) ++g;
+    return g;
+}
+
+uint64_t drg_ticks_from_ns(uint64_t ns, uint64_t sysclk_hz) {
+    return div_round_u128(mul_u64(ns, sysclk_hz), 4000000000ull);
+}
+
+uint64_t drg_ns_from_ticks(uint64_t ticks, uint64_t sysclk_hz) {
+    if (sysclk_hz == 0) return 0;
+    return div_round_u128(mul_u64(ticks, 4000000000ull), sysclk_hz);
+}
+
+bool best_step_rate(uint64_t sysclk_hz, uint32_t f_mod_hz, uint16_t& step, uint64_t& step_rate) {
+    if (step == 0 || f_mod_hz == 0 || sysclk_hz == 0) {
+        step_rate = 0;
+        step      = 0;
+        return false;
+    }
+    const uint64_t den = 4ull * f_mod_hz * step;                // ≤ 2^50
+    step_rate = (sysclk_hz + den - 1u) / den;                   // ceil
+
+    const u128_t   den2 = mul_u64(4ull * step_rate, f_mod_hz);
+    const uint64_t eff  = (den2.hi != 0) ? 0 : sysclk_hz / den2.lo;
+    step = static_cast<uint16_t>(eff > 0xFFFFu ? 0xFFFFu : eff);
+    return true;
+}
+
+} // namespace ad9910_math
@@ -0,0 +1,162 @@
+#include "dds/ad9910/ad9910_math.h"
+
+// Vector versions of ftw_from_hz_batch's multiply-shift (see ad9910_math.h for the bound).
+// With k ≥ 33 the 96-bit f × R only matters from bit 32 up:
+//   lo  = f × R[31:0]                       (32×32 → 64)
+//   mid = f × R[63:32] + (lo >> 32)         (< 2^64, and < 2^k when f < sysclk)
+//   FTW = (mid + 2^(k-33)) >> (k-32)        (the low word of lo can't carry into the rounding)
+// so each lane is two 32×32→64 multiplies, an add and a shift: _mm_mul_epu32 / vmull_u32.
+// f ≥ sysclk lanes are forced to 0xFFFFFFFF, f = 0 gives 0 by itself.
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+    #include <immintrin.h>
+    #define AD9910_SIMD_X86 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define AD9910_SIMD_NEON 1
+#endif
+
+namespace ad9910_math {
+
+#if defined(AD9910_SIMD_X86) && defined(__SSE2__)
+
+// ----------------------------------------
+//               SSE2 (4 lanes)
+// ----------------------------------------
+static size_t batch_sse2(const uint32_t* f, uint32_t* out, size_t n, const ftw_recip_t& rc) {
+    const __m128i r_lo = _mm_set1_epi64x(static_cast<long long>(rc.r & 0xFFFFFFFFu));
+    const __m128i r_hi = _mm_set1_epi64x(static_cast<long long>(rc.r >> 32));
+    const __m128i half = _mm_set1_epi64x(static_cast<long long>(uint64_t(1) << (rc.shift - 33u)));
+    const __m128i cnt  = _mm_cvtsi32_si128(rc.shift - 32);
+    const __m128i low  = _mm_set1_epi64x(0xFFFFFFFFll);
+    const __m128i bias = _mm_set1_epi32(INT32_MIN);                     // unsigned compare via signed
+    const __m128i s_b  = _mm_set1_epi32(static_cast<int32_t>(rc.sysclk_hz ^ 0x80000000u));
+    const __m128i ones = _mm_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f + i));
+        const __m128i vo = _mm_srli_epi64(v, 32);                       // lanes 1, 3 → 0, 2
+
+        const __m128i lo_e  = _mm_mul_epu32(v,  r_lo);
+        const __m128i lo_o  = _mm_mul_epu32(vo, r_lo);
+        const __m128i mid_e = _mm_add_epi64(_mm_mul_epu32(v,  r_hi), _mm_srli_epi64(lo_e, 32));
+        const __m128i mid_o = _mm_add_epi64(_mm_mul_epu32(vo, r_hi), _mm_srli_epi64(lo_o, 32));
+        const __m128i ev = _mm_and_si128(_mm_srl_epi64(_mm_add_epi64(mid_e, half), cnt), low);
+        const __m128i od = _mm_slli_epi64(_mm_srl_epi64(_mm_add_epi64(mid_o, half), cnt), 32);
+
+        const __m128i lt = _mm_cmplt_epi32(_mm_xor_si128(v, bias), s_b);   // f < sysclk
+        const __m128i res = _mm_or_si128(_mm_or_si128(ev, od), _mm_andnot_si128(lt, ones));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), res);
+    }
+    return i;
+}
+
+
+// ----------------------------------------
+//               AVX2 (8 lanes)
+// ----------------------------------------
+#if defined(__GNUC__) && !defined(AD9910_NO_AVX2)      // -DAD9910_NO_AVX2: SSE2 only
+#define AD9910_HAVE_AVX2 1
+__attribute__((target("avx2")))
+static size_t batch_avx2(const uint32_t* f, uint32_t* out, size_t n, const ftw_recip_t& rc) {
+    const __m256i r_lo = _mm256_set1_epi64x(static_cast<long long>(rc.r & 0xFFFFFFFFu));
+    const __m256i r_hi = _mm256_set1_epi64x(static_cast<long long>(rc.r >> 32));
+    const __m256i half = _mm256_set1_epi64x(static_cast<long long>(uint64_t(1) << (rc.shift - 33u)));
+    const __m128i cnt  = _mm_cvtsi32_si128(rc.shift - 32);
+    const __m256i low  = _mm256_set1_epi64x(0xFFFFFFFFll);
+    const __m256i bias = _mm256_set1_epi32(INT32_MIN);
+    const __m256i s_b  = _mm256_set1_epi32(static_cast<int32_t>(rc.sysclk_hz ^ 0x80000000u));
+    const __m256i ones = _mm256_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f + i));
+        const __m256i vo = _mm256_srli_epi64(v, 32);
+
+        const __m256i lo_e  = _mm256_mul_epu32(v,  r_lo);
+        const __m256i lo_o  = _mm256_mul_epu32(vo, r_lo);
+        const __m256i mid_e = _mm256_add_epi64(_mm256_mul_epu32(v,  r_hi), _mm256_srli_epi64(lo_e, 32));
+        const __m256i mid_o = _mm256_add_epi64(_mm256_mul_epu32(vo, r_hi), _mm256_srli_epi64(lo_o, 32));
+        const __m256i ev = _mm256_and_si256(_mm256_srl_epi64(_mm256_add_epi64(mid_e, half), cnt), low);
+        const __m256i od = _mm256_slli_epi64(_mm256_srl_epi64(_mm256_add_epi64(mid_o, half), cnt), 32);
+
+        const __m256i lt = _mm256_cmpgt_epi32(s_b, _mm256_xor_si256(v, bias));
+        const __m256i res = _mm256_or_si256(_mm256_or_si256(ev, od), _mm256_andnot_si256(lt, ones));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), res);
+    }
+    return i;
+}
+
+static bool has_avx2() {
+    static const bool yes = __builtin_cpu_supports("avx2");
+    return yes;
+}
+#endif // __GNUC__
+
+#elif defined(AD9910_SIMD_NEON)
+
+// ----------------------------------------
+//               NEON (4 lanes)
+// ----------------------------------------
+static size_t batch_neon(const uint32_t* f, uint32_t* out, size_t n, const ftw_recip_t& rc) {
+    const uint32x2_t r_lo  = vdup_n_u32(static_cast<uint32_t>(rc.r & 0xFFFFFFFFu));
+    const uint32x2_t r_hi  = vdup_n_u32(static_cast<uint32_t>(rc.r >> 32));
+    const uint64x2_t half  = vdupq_n_u64(uint64_t(1) << (rc.shift - 33u));
+    const int64x2_t  shr   = vdupq_n_s64(-int64_t(rc.shift - 32u));     // vshl by a negative count
+    const uint32x4_t sys   = vdupq_n_u32(rc.sysclk_hz);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const uint32x4_t v = vld1q_u32(f + i);
+        const uint32x2_t a = vget_low_u32(v);
+        const uint32x2_t b = vget_high_u32(v);
+
+        const uint64x2_t lo_a  = vmull_u32(a, r_lo);
+        const uint64x2_t lo_b  = vmull_u32(b, r_lo);
+        const uint64x2_t mid_a = vaddq_u64(vmull_u32(a, r_hi), vshrq_n_u64(lo_a, 32));
+        const uint64x2_t mid_b = vaddq_u64(vmull_u32(b, r_hi), vshrq_n_u64(lo_b, 32));
+        const uint32x2_t ra = vmovn_u64(vshlq_u64(vaddq_u64(mid_a, half), shr));
+        const uint32x2_t rb = vmovn_u64(vshlq_u64(vaddq_u64(mid_b, half), shr));
+
+        const uint32x4_t ge = vcgeq_u32(v, sys);                        // f ≥ sysclk → all ones
+        vst1q_u32(out + i, vorrq_u32(vcombine_u32(ra, rb), ge));
+    }
+    return i;
+}
+
+#endif
+
+
+// ----------------------------------------
+//               DISPATCH
+// ----------------------------------------
+size_t ftw_batch_simd(const uint32_t* freq_hz, uint32_t* ftw_out, size_t n, const ftw_recip_t& rc) {
+    if (!freq_hz || !ftw_out || rc.r == 0 || rc.shift < 33) return 0;   // kernels assume k ≥ 33
+#if defined(AD9910_SIMD_X86) && defined(__SSE2__)
+  #if defined(AD9910_HAVE_AVX2)
+    if (has_avx2()) return batch_avx2(freq_hz, ftw_out, n, rc);
+  #endif
+    return batch_sse2(freq_hz, ftw_out, n, rc);
+#elif defined(AD9910_SIMD_NEON)
+    return batch_neon(freq_hz, ftw_out, n, rc);
+#else
+    (void)n;
+    return 0;
+#endif
+}
+
+const char* ftw_batch_kernel() {
+#if defined(AD9910_SIMD_X86) && defined(__SSE2__)
+  #if defined(AD9910_HAVE_AVX2)
+    if (has_avx2()) return "avx2";
+  #endif
+    return "sse2";
+#elif defined(AD9910_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace ad9910_math
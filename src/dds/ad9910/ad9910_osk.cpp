@@ -0,0 +1,69 @@
+# include "dds/ad9910/ad9910.h"
+# include "dds/ad9910/ad9910_registers.h"
+# include "dds/ad9910/ad9910_math.h"
+
+
+// ----------------------------------------
+//           OUTPUT SHIFT KEYING
+// ----------------------------------------
+namespace {
+    // 1, 2, 4, 8 → ASF STEP_SIZE code, 0 → let osk_fit choose, anything else invalid
+    bool osk_step_code(uint8_t step_lsb, uint8_t& code) {
+        switch (step_lsb) {
+            case 0: code = 0xFFu; return true;
+            case 1: code = 0;     return true;
+            case 2: code = 1;     return true;
+            case 4: code = 2;     return true;
+            case 8: code = 3;     return true;
+            default:              return false;
+        }
+    }
+}
+
+// Pin low first so nothing ramps while the registers change, then ASF + CFR1 in one burst
+dds_status_t AD9910::dds_osk_auto(int32_t ampl_cdb, uint64_t rise_ns, uint8_t step_lsb, uint64_t* achieved_ns) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    uint8_t code = 0;
+    if (!osk_step_code(step_lsb, code)) return dds_status_t::DDS_INVALID_PARAM;
+    const uint64_t sysclk = dds_sysclk_hz();
+    if (sysclk == 0) return dds_status_t::DDS_NOT_INITIALIZED;
+
+    const uint16_t asf = ad9910_math::asf_from_cdb(ampl_cdb);
+    if (asf == 0) return dds_status_t::DDS_INVALID_PARAM;
+    uint16_t rate = 1u;
+    const uint64_t ticks = ad9910_math::osk_fit(asf, ad9910_math::drg_ticks_from_ns(rise_ns, sysclk), code, rate);
+
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( pin_write(idx(DdsPin::OSK), HWAbstraction::HW_PIN_LOW) ,s,s);
+    RegisterBatch b;
+    b.add<ad9910_reg::ASF >(ad9910_reg::ASF::osk(rate, asf, code));
+    b.add<ad9910_reg::CFR1>(ad9910_reg::CFR1::osk_enable(true, regs_.cfr1));
+    TRY_OK( dds_reg_flush(b)        ,s,s);
+    TRY_OK( dds_update_io_pulse()   ,s,s);
+    if (achieved_ns) *achieved_ns = ad9910_math::drg_ns_from_ticks(ticks, sysclk);
+    return s;
+}
+
+dds_status_t AD9910::dds_osk_manual(int32_t ampl_cdb) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( pin_write(idx(DdsPin::OSK), HWAbstraction::HW_PIN_LOW) ,s,s);
+    RegisterBatch b;
+    b.add<ad9910_reg::ASF >(ad9910_reg::ASF::osk(0, ad9910_math::asf_from_cdb(ampl_cdb), 0));
+    b.add<ad9910_reg::CFR1>(ad9910_reg::CFR1::osk_enable(false, regs_.cfr1));
+    TRY_OK( dds_reg_flush(b)        ,s,s);
+    TRY_OK( dds_update_io_pulse()   ,s,s);
+    return s;
+}
+
+dds_status_t AD9910::dds_osk_key(bool on) {
+    return pin_write(idx(DdsPin::OSK), on ? HWAbstraction::HW_PIN_HIGH : HWAbstraction::HW_PIN_LOW);
+}
+
+dds_status_t AD9910::dds_osk_off() {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( dds_reg_commit<ad9910_reg::CFR1>(regs_.cfr1, ad9910_reg::CFR1::osk_disable(regs_.cfr1)) ,s,s);
+    TRY_OK( dds_update_io_pulse() ,s,s);
+    return s;
+}
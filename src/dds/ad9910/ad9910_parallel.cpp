@@ -0,0 +1,60 @@
+# include "dds/ad9910/ad9910.h"
+# include "dds/ad9910/ad9910_registers.h"
+
+
+// ----------------------------------------
+//            PARALLEL DATA PORT
+// ----------------------------------------
+// TxEnable low and the destination on F[1:0] first, so the port comes up idle; then RAM and
+// DRG off, port on, base FTW / POW, all active on one IO_UPDATE
+dds_status_t AD9910::dds_parallel_begin(const parallel_cfg_t& cfg) {
+    if (!is_initialized())  return dds_status_t::DDS_NOT_INITIALIZED;
+    if (cfg.fm_gain > 15u)  return dds_status_t::DDS_INVALID_PARAM;
+    const uint8_t f = static_cast<uint8_t>(cfg.dest);
+    auto lvl = [f](uint8_t bit) { return (f & bit) ? HWAbstraction::HW_PIN_HIGH : HWAbstraction::HW_PIN_LOW; };
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    TRY_OK( pin_write(idx(DdsPin::TX_ENABLE), HWAbstraction::HW_PIN_LOW) ,s,s);
+    TRY_OK( pin_write(idx(DdsPin::F0), lvl(0x01))                        ,s,s);
+    TRY_OK( pin_write(idx(DdsPin::F1), lvl(0x02))                        ,s,s);
+
+    Transaction t(*this);
+    t.write<ad9910_reg::CFR1>(ad9910_reg::CFR1::ram_disable(regs_.cfr1))
+     .write<ad9910_reg::CFR2>(ad9910_reg::CFR2::parallel_enable(cfg.fm_gain, cfg.hold_last, regs_.cfr2))
+     .write<ad9910_reg::FTW >(ad9910_reg::FTW::value_type(cfg.ftw))
+     .write<ad9910_reg::POW >(ad9910_reg::POW::value_type(cfg.pow));
+    TRY_OK( t.commit() ,s,s);
+    return s;
+}
+
+dds_status_t AD9910::dds_parallel_stream(const uint16_t* words, uint32_t count, uint32_t period_ns, bool circular) {
+    if (!is_initialized())          return dds_status_t::DDS_NOT_INITIALIZED;
+    if (!words || count == 0)       return dds_status_t::DDS_INVALID_PARAM;
+    if (uint64_t(period_ns) * sysclk_hz_ < 4000000000ull)                 // shorter than PDCLK: words lost
+        return dds_status_t::DDS_INVALID_PARAM;
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    TRY_OK( from_hw(hw_.hw_parallel_start(words, count, period_ns, circular)) ,s,s);   // word 0 on the bus
+    TRY_OK( pin_write(idx(DdsPin::TX_ENABLE), HWAbstraction::HW_PIN_HIGH)      ,s,s);   // chip takes it from here
+    return s;
+}
+
+uint32_t AD9910::dds_parallel_position() const {
+    return hw_.hw_parallel_position();
+}
+
+dds_status_t AD9910::dds_parallel_stop() {
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( pin_write(idx(DdsPin::TX_ENABLE), HWAbstraction::HW_PIN_LOW) ,s,s);
+    TRY_OK( from_hw(hw_.hw_parallel_stop())                              ,s,s);
+    return s;
+}
+
+dds_status_t AD9910::dds_parallel_end() {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( pin_write(idx(DdsPin::TX_ENABLE), HWAbstraction::HW_PIN_LOW) ,s,s);
+    TRY_OK( dds_reg_commit<ad9910_reg::CFR2>(regs_.cfr2, ad9910_reg::CFR2::parallel_disable(regs_.cfr2)) ,s,s);
+    TRY_OK( dds_update_io_pulse() ,s,s);
+    return s;
+}
@@ -0,0 +1,111 @@
+#include "dds/ad9910/ad9910_profile_sequencer.h"
+#include "dds/dds_protocol.h"
+
+
+// ----------------------------------------
+//               PREPARE
+// ----------------------------------------
+void ProfileSequencer::prepare(const AD9910& dds,
+                               const uint32_t* freqs_hz,
+                               size_t n,
+                               int16_t ampl_db,
+                               entry_t* out)
+{
+    if (!freqs_hz || !out) return;
+    const uint16_t asf = AD9910::dds_ampl_asf(ampl_db);     // same amplitude for the whole list
+    for (size_t i = 0; i < n; ++i)
+        out[i] = { dds.dds_freq_ftw(freqs_hz[i]), 0, asf };
+}
+
+ProfileSequencer::frame_t ProfileSequencer::frame(uint32_t ftw, uint16_t pow, uint16_t asf) {
+    frame_t f;
+    const auto b = ad9910_reg::PROFILE0::bytes(ad9910_reg::PROFILE0::single_tone(ftw, pow, asf));
+    for (size_t i = 0; i < sizeof(f.bytes); ++i) f.bytes[i] = b[i];
+    return f;
+}
+
+dds_status_t ProfileSequencer::stream_entries(stream_t& stream, const uint8_t* payload, uint8_t len, size_t* next) {
+    using namespace dds_proto;
+    if (!payload || !next || len < WORD_HEADER || (len - WORD_HEADER) % ENTRY_BYTES != 0)
+        return dds_status_t::DDS_INVALID_PARAM;
+    if (get_u16(payload) != uint16_t(*next)) return dds_status_t::DDS_INVALID_PARAM;
+    const uint8_t n = uint8_t((len - WORD_HEADER) / ENTRY_BYTES);
+    if (stream_t::CAPACITY - stream.size() < n) { stream.note_overrun(); return dds_status_t::DDS_TIMEOUT; }
+
+    for (uint8_t i = 0; i < n; ++i) {
+        const uint8_t* p = payload + WORD_HEADER + i * ENTRY_BYTES;
+        stream.push(frame(get_u32(p), get_u16(p + 4), get_u16(p + 6)));     // room checked above
+    }
+    *next += n;
+    return dds_status_t::DDS_OK;
+}
+
+
+// ----------------------------------------
+//               PLAYBACK
+// ----------------------------------------
+dds_status_t ProfileSequencer::load(size_t i, bool io_update) {
+    const uint8_t slot = static_cast<uint8_t>(i % SLOTS);
+    if (stream_) {
+        // Peek, write, then release: a failed SPI write leaves the entry in the ring
+        uint8_t avail = 0;
+        const frame_t* f = stream_->read_span(&avail);
+        if (avail == 0) return dds_status_t::DDS_TIMEOUT;
+        const dds_status_t s = dds_.dds_profile_load_raw(slot, f->bytes, io_update);
+        if (s == dds_status_t::DDS_OK) stream_->release(1);
+        return s;
+    }
+    const entry_t& e = list_[i];
+    return dds_.dds_profile_load(slot, e.ftw, e.pow, e.asf, io_update);
+}
+
+dds_status_t ProfileSequencer::start(const entry_t* list, size_t n) {
+    if (!list || n == 0) return dds_status_t::DDS_INVALID_PARAM;
+    list_   = list;
+    stream_ = nullptr;
+    return begin(n, (n < SLOTS) ? n : SLOTS);
+}
+
+dds_status_t ProfileSequencer::start(stream_t& stream, size_t n) {
+    if (n == 0) return dds_status_t::DDS_INVALID_PARAM;
+    size_t first = stream.size();
+    if (first == 0) return dds_status_t::DDS_TIMEOUT;
+    if (first > SLOTS) first = SLOTS;
+    if (first > n)     first = n;
+    list_   = nullptr;
+    stream_ = &stream;
+    return begin(n, first);
+}
+
+dds_status_t ProfileSequencer::begin(size_t n, size_t first) {
+    count_     = n;
+    pos_       = 0;
+    loaded_    = 0;
+    underruns_ = 0;
+    done_      = false;
+
+    dds_status_t s = dds_status_t::DDS_OK;
+    for (size_t i = 0; i < first; ++i) {
+        TRY_OK( load(i, i + 1 == first) ,s,s);    // a single IO_UPDATE for the whole preload
+        ++loaded_;
+    }
+    return dds_.dds_profile_select(0);
+}
+
+dds_status_t ProfileSequencer::trigger() {
+    if (!running()) return dds_status_t::DDS_NOT_INITIALIZED;
+    const size_t next = pos_ + 1;
+    if (next >= count_) { done_ = true; return dds_status_t::DDS_OK; }
+    if (next >= loaded_) { ++underruns_; return dds_status_t::DDS_TIMEOUT; }
+    pos_ = next;
+    return dds_.dds_profile_select(static_cast<uint8_t>(next % SLOTS));
+}
+
+bool ProfileSequencer::service() {
+    if (!running() || loaded_ >= count_) return false;
+    // Slot loaded_ % 8 still holds entry loaded_ - 8: free once the output has moved past it
+    if (loaded_ >= pos_ + SLOTS) return false;
+    if (load(loaded_, true) != dds_status_t::DDS_OK) return true;   // retry on the next call (stream: no data yet)
+    ++loaded_;
+    return loaded_ < count_ && loaded_ < pos_ + SLOTS;
+}
@@ -0,0 +1,95 @@
+# include "dds/ad9910/ad9910.h"
+# include "dds/ad9910/ad9910_registers.h"
+
+
+// ----------------------------------------
+//               RAM PROFILES
+// ----------------------------------------
+uint16_t AD9910::dds_ram_step_rate(uint32_t step_ns) const {
+    // step_ns = 4 × M / f_SYSCLK  →  M = step_ns × f_SYSCLK / 4e9 (rounded)
+    const uint64_t m = (uint64_t(step_ns) * sysclk_hz_ + 2000000000ull) / 4000000000ull;
+    if (m < 1u)      return 1u;
+    if (m > 0xFFFFu) return 0xFFFFu;
+    return static_cast<uint16_t>(m);
+}
+
+dds_status_t AD9910::dds_ram_profile(uint8_t index, const ram_profile_t& p) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    if (index > 7 || p.step_rate == 0 || p.start > p.end ||
+        p.end >= ad9910_reg::RAM_PROFILE::RAM_WORDS)     return dds_status_t::DDS_INVALID_PARAM;
+
+    const auto v = ad9910_reg::RAM_PROFILE::set_ram(p.start, p.end, p.step_rate, p.mode,
+                                                    p.no_dwell_high, p.zero_crossing);
+    const auto b = ad9910_reg::RAM_PROFILE::bytes(v);
+    return dds_reg_write(static_cast<uint8_t>(ad9910_reg::RAM_PROFILE::address + index), b.data(), b.size());
+}
+
+
+// ----------------------------------------
+//               RAM UPLOAD
+// ----------------------------------------
+dds_status_t AD9910::dds_ram_stream(const uint32_t* words, uint16_t count) {
+    constexpr uint8_t CHUNK_WORDS = 16;                 // 64 B on the stack
+    const uint8_t cs = pin_indices_[idx(DdsPin::SPI_CS)];
+    uint8_t chunk[CHUNK_WORDS * 4];
+
+    dds_status_t s = from_hw(hw_.hw_pin_write(cs, HWAbstraction::HW_PIN_LOW));
+    if (s == dds_status_t::DDS_OK) {
+        const uint8_t header = static_cast<uint8_t>(ad9910_reg::Reg::RAM);
+        s = spi_tx(&header, 1);
+    }
+    for (uint16_t i = 0; i < count && s == dds_status_t::DDS_OK; ) {
+        const uint16_t n = (count - i < CHUNK_WORDS) ? uint16_t(count - i) : uint16_t(CHUNK_WORDS);
+        for (uint16_t k = 0; k < n; k++) {
+            const uint32_t w = words[i + k];
+            chunk[4 * k + 0] = static_cast<uint8_t>(w >> 24);
+            chunk[4 * k + 1] = static_cast<uint8_t>(w >> 16);
+            chunk[4 * k + 2] = static_cast<uint8_t>(w >>  8);
+            chunk[4 * k + 3] = static_cast<uint8_t>(w      );
+        }
+        s = spi_tx(chunk, size_t(n) * 4u);
+        i = uint16_t(i + n);
+    }
+    const dds_status_t r = from_hw(hw_.hw_pin_write(cs, HWAbstraction::HW_PIN_HIGH)); // always release CS
+    return s != dds_status_t::DDS_OK ? s : r;
+}
+
+dds_status_t AD9910::dds_ram_load(uint8_t index, const ram_profile_t& p, const uint32_t* words) {
+    if (!words) return dds_status_t::DDS_INVALID_PARAM;
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    // The RAM write range comes from the active, selected profile
+    TRY_OK( dds_ram_profile(index, p)                            ,s,s);
+    TRY_OK( dds_update_io_pulse()                                ,s,s);
+    TRY_OK( dds_profile_select(index)                            ,s,s);
+    TRY_OK( dds_ram_stream(words, uint16_t(p.end - p.start + 1u)) ,s,s);
+    return s;
+}
+
+
+// ----------------------------------------
+//               PLAYBACK
+// ----------------------------------------
+dds_status_t AD9910::dds_ram_play(uint8_t index, RamDest dest, uint32_t ftw) {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    if (index > 7)         return dds_status_t::DDS_INVALID_PARAM;
+    dds_status_t s = dds_status_t::DDS_OK;
+
+    RegisterBatch b;
+    b.add<ad9910_reg::CFR2>(ad9910_reg::CFR2::set<ad9910_reg::CFR2::DR_ENABLE>(false, regs_.cfr2));   // DRG off
+    if (dest != RamDest::Frequency)                                                                    // carrier from FTW
+        b.add<ad9910_reg::FTW>(ad9910_reg::FTW::value_type(ftw));
+    b.add<ad9910_reg::CFR1>(ad9910_reg::CFR1::ram_enable(dest, regs_.cfr1));
+    TRY_OK( dds_reg_flush(b)            ,s,s);
+    TRY_OK( dds_profile_select(index)   ,s,s);
+    TRY_OK( dds_update_io_pulse()       ,s,s);      // playback starts here
+    return s;
+}
+
+dds_status_t AD9910::dds_ram_stop() {
+    if (!is_initialized()) return dds_status_t::DDS_NOT_INITIALIZED;
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( dds_reg_commit<ad9910_reg::CFR1>(regs_.cfr1, ad9910_reg::CFR1::ram_disable(regs_.cfr1)) ,s,s);
+    TRY_OK( dds_update_io_pulse() ,s,s);
+    return s;
+}
@@ -7,21 +7,15 @@
 //                 CFR1
 // ----------------------------------------
 dds_status_t AD9910::dds_cfr1_defaults(){ 
-    auto r      = ad9910_reg::CFR1::defaults();
-    auto b      = ad9910_reg::CFR1::bytes(r);
-    return dds_reg_write(ad9910_reg::CFR1::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::CFR1>(regs_.cfr1, ad9910_reg::fixed::CFR1_DEFAULTS);
 }
 
 dds_status_t AD9910::dds_cfr1_drg_setup(){
-    auto r      = ad9910_reg::CFR1::drg_setup();
-    auto b      = ad9910_reg::CFR1::bytes(r);
-    return dds_reg_write(ad9910_reg::CFR1::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::CFR1>(regs_.cfr1, ad9910_reg::fixed::CFR1_DRG_SETUP);
 }
 
 dds_status_t AD9910::dds_cfr1_drg_basic(){
-    auto r      = ad9910_reg::CFR1::drg_basic();
-    auto b      = ad9910_reg::CFR1::bytes(r);
-    return dds_reg_write(ad9910_reg::CFR1::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::CFR1>(regs_.cfr1, ad9910_reg::CFR1::drg_basic(regs_.cfr1));
 }
 
 
@@ -29,15 +23,12 @@ dds_status_t AD9910::dds_cfr1_drg_basic(){
 //                 CFR2
 // ----------------------------------------
 dds_status_t AD9910::dds_cfr2_defaults(){
-    auto r      = ad9910_reg::CFR2::defaults();
-    auto b      = ad9910_reg::CFR2::bytes(r);
-    return dds_reg_write(ad9910_reg::CFR2::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::CFR2>(regs_.cfr2, ad9910_reg::fixed::CFR2_DEFAULTS);
 }
 
 dds_status_t AD9910::dds_cfr2_drg_freq_enable(bool continuous){
-    auto r      = ad9910_reg::CFR2::drg_freq_enable(continuous);
-    auto b      = ad9910_reg::CFR2::bytes(r);
-    return dds_reg_write(ad9910_reg::CFR2::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::CFR2>(regs_.cfr2, continuous ? ad9910_reg::fixed::CFR2_DRG_FREQ_CONT
+                                                                   : ad9910_reg::fixed::CFR2_DRG_FREQ);
 }
 
 // ----------------------------------------
@@ -47,14 +38,11 @@ dds_status_t AD9910::dds_cfr2_drg_freq_enable(bool continuous){
 dds_status_t AD9910::dds_cfr3_defaults( bool ref_div2       ,
                                         bool pll_enable     , 
                                         uint8_t pll_mult    ,
-                                        VcoSel vco_sel  = VcoSel::VCO5  ,  // GRA & AFCH default 
-                                        IcpCode icp     = IcpCode::u387 ){ // GRA & AFCH default
-
-    auto r = pll_enable
-                ? ad9910_reg::CFR3::default_pll_on (ref_div2,pll_mult,vco_sel,icp)                  
-                : ad9910_reg::CFR3::default_pll_off(ref_div2);
-    auto bytes = ad9910_reg::CFR3::bytes(r);
-    return dds_reg_write(ad9910_reg::CFR3::address, bytes.data(), bytes.size());
+                                        ad9910_reg::CFR3::VcoSel  vco_sel,
+                                        ad9910_reg::CFR3::IcpCode icp ){
+
+    auto r = ad9910_reg::CFR3::defaults(ref_div2, pll_enable, pll_mult, vco_sel, icp);
+    return dds_reg_commit<ad9910_reg::CFR3>(regs_.cfr3, r);
 }
 
 
@@ -62,36 +50,29 @@ dds_status_t AD9910::dds_cfr3_defaults( bool ref_div2       ,
 //                  AUX
 // ----------------------------------------
 dds_status_t AD9910::dds_aux_dac_fsc(bool high_current) {
-    auto r      = ad9910_reg::AUX_DAC::defaults(high_current);
-    auto b      = ad9910_reg::AUX_DAC::bytes(r);
-    return dds_reg_write(ad9910_reg::AUX_DAC::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::AUX_DAC>(regs_.aux_dac, high_current ? ad9910_reg::fixed::AUX_DAC_FSC_HIGH
+                                                                          : ad9910_reg::fixed::AUX_DAC_FSC_NORMAL);
 }
 
 // ----------------------------------------
 //                 DR_LIMIT
 // ----------------------------------------
 dds_status_t AD9910::dds_drg_set_limit(uint32_t lower, uint32_t upper){
-    auto r      = ad9910_reg::DR_LIMIT::set_limit(lower, upper);
-    auto b      = ad9910_reg::DR_LIMIT::bytes(r);
-    return dds_reg_write(ad9910_reg::DR_LIMIT::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::DR_LIMIT>(regs_.dr_limit, ad9910_reg::DR_LIMIT::set_limit(lower, upper));
 }
 
 // ----------------------------------------
 //                 DR_STEP
 // ----------------------------------------
 dds_status_t AD9910::dds_drg_set_step(uint32_t incr , uint32_t decr){
-    auto r      = ad9910_reg::DR_STEP::set_step(incr, decr);
-    auto b      = ad9910_reg::DR_STEP::bytes(r);
-    return dds_reg_write(ad9910_reg::DR_STEP::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::DR_STEP>(regs_.dr_step, ad9910_reg::DR_STEP::set_step(incr, decr));
 }
 
 // ----------------------------------------
 //                 DR_RATE
 // ----------------------------------------
 dds_status_t AD9910::dds_drg_set_rate(uint16_t pos, uint16_t neg){
-    auto r      = ad9910_reg::DR_RATE::set_rate(pos, neg);
-    auto b      = ad9910_reg::DR_RATE::bytes(r);
-    return dds_reg_write(ad9910_reg::DR_RATE::address, b.data(), b.size());
+    return dds_reg_commit<ad9910_reg::DR_RATE>(regs_.dr_rate, ad9910_reg::DR_RATE::set_rate(pos, neg));
 }
 
 // ----------------------------------------
@@ -145,33 +126,29 @@ dds_status_t AD9910::dds_drg_program_range(uint32_t ftw_start,
                                            uint32_t ftw_step,
                                            uint16_t step_rate)
 {   
-    dds_status_t s = dds_status_t::DDS_OK;
-
-    // DR_LIMIT: upper = ftw_end, lower = ftw_start (8 bytes)
-    std::uint64_t v =
-        (static_cast<std::uint64_t>(ftw_end)  << 32) |
-            static_cast<std::uint64_t>(ftw_start);
-
-    auto b = pack_be<8>(v);
-    TRY_OK( dds_reg_write(ad9910_reg::DR_LIMIT::address, b.data(), b.size())  ,s,s);
-    
-    // DR_STEP: neg = ftw_step, pos = ftw_step (8 bytes)
-    std::uint64_t v =
-        (static_cast<std::uint64_t>(ftw_step) << 32) |
-            static_cast<std::uint64_t>(ftw_step);
-
-    auto b = pack_be<8>(v);
-    TRY_OK( dds_reg_write(ad9910_reg::DR_STEP::address, b.data(), b.size())  ,s,s);
-
-    // DR_RATE: neg = step_rate, pos = step_rate (4 bytes)
-    std::uint32_t v =
-        (static_cast<std::uint32_t>(step_rate) << 16) |
-            static_cast<std::uint32_t>(step_rate);
-
-    auto b = pack_be<4>(v);
-    return dds_reg_write(ad9910_reg::DR_RATE::address, b.data(), b.size());
+    RegisterBatch b;
+    dds_drg_batch_range(b, ftw_start, ftw_end, ftw_step, step_rate);
+    return dds_reg_flush(b);                                // one CS assertion for the three registers
 }
 
+void AD9910::dds_drg_batch_range(RegisterBatch& b,
+                                 uint32_t ftw_start,
+                                 uint32_t ftw_end,
+                                 uint32_t ftw_step,
+                                 uint16_t step_rate)
+{
+    dds_drg_batch_range(b, ftw_start, ftw_end, ftw_step, ftw_step, step_rate, step_rate);   // neg = pos
+}
 
-
-
+void AD9910::dds_drg_batch_range(RegisterBatch& b,
+                                 uint32_t ftw_lower,
+                                 uint32_t ftw_upper,
+                                 uint32_t step_up,
+                                 uint32_t step_down,
+                                 uint16_t rate_up,
+                                 uint16_t rate_down)
+{
+    b.add<ad9910_reg::DR_LIMIT>(ad9910_reg::DR_LIMIT::set_limit(ftw_lower, ftw_upper));
+    b.add<ad9910_reg::DR_STEP >(ad9910_reg::DR_STEP::set_step(step_up, step_down));     // inc = up, dec = down
+    b.add<ad9910_reg::DR_RATE >(ad9910_reg::DR_RATE::set_rate(rate_up, rate_down));     // pos = up, neg = down
+}
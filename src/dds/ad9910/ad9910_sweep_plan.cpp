@@ -0,0 +1,113 @@
+#include "dds/ad9910/ad9910_sweep_plan.h"
+
+
+// ----------------------------------------
+//               COMPILE
+// ----------------------------------------
+namespace {
+    template<typename R>
+    uint8_t* put_frame(uint8_t* p, typename R::value_type v) {
+        const auto f = R::frame(v);
+        for (size_t i = 0; i < f.size(); ++i) p[i] = f[i];
+        return p + f.size();
+    }
+}
+
+dds_status_t SweepPlan::compile(const AD9910& dds,
+                                const point_t* pts,
+                                size_t n,
+                                segment_t* out,
+                                uint64_t* max_error_ns)
+{
+    if (!pts || !out || n < 2) return dds_status_t::DDS_INVALID_PARAM;
+    const uint64_t sysclk = dds.dds_sysclk_hz();
+    if (sysclk == 0) return dds_status_t::DDS_NOT_INITIALIZED;
+    for (size_t i = 1; i < n; ++i)
+        if (pts[i].t_ns <= pts[i - 1].t_ns) return dds_status_t::DDS_INVALID_PARAM;
+
+    uint64_t done_ticks = 0;            // achieved so far, in DRG ticks from pts[0]
+    uint64_t worst_ns   = 0;
+    uint32_t ftw_a      = dds.dds_freq_ftw(pts[0].freq_hz);
+
+    for (size_t i = 0; i + 1 < n; ++i) {
+        const uint32_t ftw_b  = dds.dds_freq_ftw(pts[i + 1].freq_hz);
+        const uint64_t target = ad9910_math::drg_ticks_from_ns(pts[i + 1].t_ns - pts[0].t_ns, sysclk);
+        const uint64_t want   = target > done_ticks ? target - done_ticks : 1u;
+
+        segment_t& seg = out[i];
+        seg.ftw_start  = ftw_a;
+        uint32_t lower = ftw_a, upper = ftw_b, step = 0xFFFFFFFFu;
+        uint16_t rate  = 1;
+        uint64_t got   = want;          // a hold lasts exactly as long as the timer says
+        if (ftw_b > ftw_a) {
+            seg.dir = Dir::UP;
+            got = ad9910_math::drg_fit(ftw_b - ftw_a, want, step, rate);
+        } else if (ftw_b < ftw_a) {
+            seg.dir = Dir::DOWN;
+            lower = ftw_b; upper = ftw_a;
+            got = ad9910_math::drg_fit(ftw_a - ftw_b, want, step, rate);
+        } else {
+            seg.dir = Dir::HOLD;
+        }
+
+        uint8_t* p = seg.frames;
+        p = put_frame<ad9910_reg::DR_LIMIT>(p, ad9910_reg::DR_LIMIT::set_limit(lower, upper));
+        p = put_frame<ad9910_reg::DR_STEP >(p, ad9910_reg::DR_STEP::set_step(step, step));
+        put_frame<ad9910_reg::DR_RATE>(p, ad9910_reg::DR_RATE::set_rate(rate, rate));
+        seg.duration_ns = ad9910_math::drg_ns_from_ticks(got, sysclk);
+
+        done_ticks += got;
+        const uint64_t err = done_ticks > target ? done_ticks - target : target - done_ticks;
+        const uint64_t err_ns = ad9910_math::drg_ns_from_ticks(err, sysclk);
+        if (err_ns > worst_ns) worst_ns = err_ns;
+        ftw_a = ftw_b;
+    }
+    if (max_error_ns) *max_error_ns = worst_ns;
+    return dds_status_t::DDS_OK;
+}
+
+
+// ----------------------------------------
+//               PLAYBACK
+// ----------------------------------------
+dds_status_t SweepPlan::arm(size_t i) {
+    const segment_t& seg = segs_[i];
+    seen_low_ = false;
+    return dds_.dds_drg_chirp_segment(seg.frames, FRAME_BYTES, seg.dir != Dir::DOWN);
+}
+
+dds_status_t SweepPlan::start(const segment_t* segs, size_t n, Rearm mode) {
+    if (!segs || n == 0) return dds_status_t::DDS_INVALID_PARAM;
+    if (mode == Rearm::DROVER)
+        for (size_t i = 0; i < n; ++i)
+            if (segs[i].dir == Dir::HOLD || segs[i].duration_ns < DROVER_MIN_NS)
+                return dds_status_t::DDS_INVALID_PARAM;
+
+    segs_  = segs;
+    count_ = n;
+    pos_   = 0;
+    mode_  = mode;
+    done_  = false;
+
+    dds_status_t s = dds_status_t::DDS_OK;
+    TRY_OK( dds_.dds_drg_chirp_begin(segs[0].ftw_start) ,s,s);
+    return arm(0);
+}
+
+dds_status_t SweepPlan::next() {
+    if (!segs_) return dds_status_t::DDS_NOT_INITIALIZED;
+    if (pos_ + 1 >= count_) { done_ = true; return dds_status_t::DDS_OK; }
+    ++pos_;
+    return arm(pos_);
+}
+
+bool SweepPlan::service() {
+    if (!segs_ || done_ || mode_ != Rearm::DROVER) return false;
+    bool over = false;
+    if (dds_.dds_drover(&over) != dds_status_t::DDS_OK) return true;
+    // DROVER can still show the previous limit right after arming: wait for it to drop first
+    if (!over) { seen_low_ = true; return true; }
+    if (!seen_low_) return true;
+    next();
+    return !done_;
+}
@@ -0,0 +1,86 @@
+# include "dds/ad9910/ad9910.h"
+# include "dds/ad9910/ad9910_registers.h"
+
+
+// ----------------------------------------
+//               TRANSACTION
+// ----------------------------------------
+namespace {
+    bool fits(const RegisterBatch& b, uint8_t len) {
+        return b.count() < RegisterBatch::MAX_FRAMES &&
+               b.size() + 1u + len <= RegisterBatch::MAX_BYTES;
+    }
+}
+
+AD9910::Transaction& AD9910::Transaction::write_raw(uint8_t addr, const uint8_t* payload, uint8_t len) {
+    if (!open_ || status_ != dds_status_t::DDS_OK) return *this;
+    addr &= 0x7Fu;
+    // RAM words are not staged, so nothing could take them back
+    if (!payload || len == 0 || len != ad9910_reg::reg_len(addr) ||
+        addr == static_cast<uint8_t>(ad9910_reg::Reg::RAM)) {
+        status_ = dds_status_t::DDS_INVALID_PARAM;
+        return *this;
+    }
+    if (!fits(batch_, len)) status_ = send();                       // staged only, no pulse
+    if (status_ == dds_status_t::DDS_OK) batch_.add(addr, payload, len);
+    return *this;
+}
+
+AD9910::Transaction& AD9910::Transaction::select(uint8_t profile) {
+    if (profile > 7) status_ = dds_status_t::DDS_INVALID_PARAM;
+    else             profile_ = profile;
+    return *this;
+}
+
+dds_status_t AD9910::Transaction::send() {
+    if (batch_.empty()) return dds_status_t::DDS_OK;
+    if (sent_ == 0) saved_ = dds_.regs_;
+    for (uint8_t i = 0; i < batch_.count(); i++) sent_ |= uint32_t(1) << batch_.entry(i).addr;
+    return dds_.dds_reg_flush(batch_);
+}
+
+dds_status_t AD9910::Transaction::commit() {
+    if (!open_) return status_;
+    open_ = false;
+
+    dds_status_t s = status_;
+    if (s == dds_status_t::DDS_OK) s = send();
+    if (s == dds_status_t::DDS_OK) s = dds_.dds_update_io_pulse();    // everything goes active here
+    if (s != dds_status_t::DDS_OK) { rollback(); return status_ = s; }
+
+    if (profile_ <= 7) s = dds_.dds_profile_select(profile_);
+    return status_ = s;
+}
+
+void AD9910::Transaction::abort() {
+    if (!open_) return;
+    open_ = false;
+    rollback();
+}
+
+// The chip only staged what went out: write the old contents back over it so the next
+// IO_UPDATE, whoever issues it, finds the active values again. The bank holds every
+// register a transaction can stage (FTW, POW, IO_UPDATE_RATE ... included).
+void AD9910::Transaction::rollback() {
+    batch_.clear();
+    if (sent_ == 0) return;
+
+    for (uint8_t a = 0; a < ad9910_reg::REG_COUNT; a++)
+        if (sent_ & (uint32_t(1) << a)) dds_.reg_cache_.invalidate(a);
+
+    RegisterBatch b;
+    dds_status_t s = dds_status_t::DDS_OK;
+    for (uint8_t a = 0; a < ad9910_reg::REG_COUNT && s == dds_status_t::DDS_OK; a++) {
+        uint64_t v = 0;
+        if (!(sent_ & (uint32_t(1) << a)) || !saved_.load(a, v)) continue;
+        const uint8_t len = ad9910_reg::reg_len(a);
+        const auto bytes = pack_be<8>(v);
+        if (!fits(b, len)) s = dds_.dds_reg_flush(b);
+        b.add(a, bytes.data() + 8 - len, len);
+    }
+    if (s == dds_status_t::DDS_OK) dds_.dds_reg_flush(b);
+    else                           b.clear();
+
+    dds_.regs_ = saved_;            // even if the rewrite failed: the cache no longer vouches for these
+    sent_ = 0;
+}
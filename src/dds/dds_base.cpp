@@ -1,7 +1,5 @@
 # include "dds/dds_base.h"
 
-const bool high   = ad9910_ctx_.dac_high_current;
-
 // --- Hardware conversion helper ---
 dds_status_t DDSBase::from_hw(HWAbstraction::hw_status_t hs) {
     return hs == HWAbstraction::HW_OK ? dds_status_t::DDS_OK : dds_status_t::DDS_HW_ERROR;}
@@ -17,6 +15,7 @@ dds_status_t DDSBase::dds_seq_run(const DdsSequence* seq, size_t count){
         auto st = pin_write(step.pin_index, step.level);
         if (st != dds_status_t::DDS_OK)
             return st;
+        dds_seq_step_hook(step);
 
         if (step.delay_us)
             hw_.hw_delay_us(step.delay_us);
@@ -93,7 +92,7 @@ dds_status_t DDSBase::dds_attach_board(const pin_t* pins, size_t pins_count) {
 
         pin_indices_[i] = idx;}
 
-    return dds_status_t::DDS_OK;
+    return dds_attach_hook();
 }
 
 
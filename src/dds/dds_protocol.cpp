@@ -0,0 +1,177 @@
+#include "dds/dds_protocol.h"
+#include <cstring>
+
+namespace dds_proto {
+
+// ----------------------------------------
+//                 CRC
+// ----------------------------------------
+// Bitwise: 8 shifts per byte beat a 512-byte table on the Mega's 8 KB of RAM, and the UART
+// is far slower than either.
+uint16_t crc16(const uint8_t* data, size_t len, uint16_t crc) {
+    if (!data) return crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= uint16_t(data[i]) << 8;
+        for (uint8_t b = 0; b < 8; ++b)
+            crc = (crc & 0x8000u) ? uint16_t((crc << 1) ^ 0x1021u) : uint16_t(crc << 1);
+    }
+    return crc;
+}
+
+
+// ----------------------------------------
+//               ENCODER
+// ----------------------------------------
+size_t encode(uint8_t cmd, const uint8_t* payload, uint8_t len, uint8_t* out, size_t cap) {
+    if (!out || len > MAX_PAYLOAD || (len && !payload)) return 0;
+    const size_t total = size_t(len) + OVERHEAD;
+    if (total > cap) return 0;
+    out[0] = SYNC;
+    out[1] = len;
+    out[2] = cmd;
+    if (len) std::memcpy(out + 3, payload, len);
+    put_u16(out + 3 + len, crc16(out + 1, size_t(len) + 2));
+    return total;
+}
+
+size_t encode_words(uint8_t cmd, uint16_t offset, const uint32_t* words, size_t n,
+                    uint8_t* out, size_t cap, size_t* used) {
+    if (!words || n == 0) return 0;
+    const size_t k = (n < WORDS_MAX) ? n : WORDS_MAX;
+    uint8_t payload[MAX_PAYLOAD];
+    put_u16(payload, offset);
+    for (size_t i = 0; i < k; ++i) put_u32(payload + WORD_HEADER + i * 4, words[i]);
+    const size_t len = encode(cmd, payload, uint8_t(WORD_HEADER + k * 4), out, cap);
+    if (used) *used = len ? k : 0;
+    return len;
+}
+
+size_t encode_profile(uint8_t slot, uint32_t ftw, uint16_t pow, uint16_t asf,
+                      uint8_t* out, size_t cap) {
+    uint8_t payload[PROFILE_BYTES];
+    payload[0] = slot;
+    put_u32(payload + 1, ftw);
+    put_u16(payload + 5, pow);
+    put_u16(payload + 7, asf);
+    return encode(CMD_PROFILE, payload, PROFILE_BYTES, out, cap);
+}
+
+size_t encode_u16(uint8_t cmd, uint16_t v, uint8_t* out, size_t cap) {
+    uint8_t payload[2];
+    put_u16(payload, v);
+    return encode(cmd, payload, 2, out, cap);
+}
+
+
+// ----------------------------------------
+//               UNPACK
+// ----------------------------------------
+dds_status_t unpack_words(const uint8_t* payload, uint8_t len,
+                          uint32_t* table, size_t cap, size_t* end) {
+    if (!payload || !table || len < WORD_HEADER || (len - WORD_HEADER) % 4 != 0)
+        return dds_status_t::DDS_INVALID_PARAM;
+    const size_t offset = get_u16(payload);
+    const size_t n      = (len - WORD_HEADER) / 4u;
+    if (offset + n > cap) return dds_status_t::DDS_INVALID_PARAM;
+    for (size_t i = 0; i < n; ++i) table[offset + i] = get_u32(payload + WORD_HEADER + i * 4);
+    if (end) *end = offset + n;
+    return dds_status_t::DDS_OK;
+}
+
+
+// ----------------------------------------
+//               DECODER
+// ----------------------------------------
+void FrameDecoder::drop(uint8_t k) {
+    n_ = uint8_t(n_ - k);
+    if (n_) std::memmove(raw_, raw_ + k, n_);
+}
+
+// Complete, CRC-valid frame at raw_[j] ending at or before end (end == n_ when exact)
+bool FrameDecoder::valid_at(uint8_t j, uint8_t end, bool exact) const {
+    if (raw_[j] != SYNC || j + 2 > n_ || raw_[j + 1] > MAX_PAYLOAD) return false;
+    const uint8_t total = uint8_t(raw_[j + 1] + OVERHEAD);
+    if (exact ? j + total != end : j + total > end) return false;
+    return get_u16(raw_ + j + total - 2) == crc16(raw_ + j + 1, size_t(raw_[j + 1]) + 2);
+}
+
+// Resolves what raw_ holds: leading bytes up to a SYNC are discarded, a candidate that
+// fails is dropped by its SYNC only, so its remaining bytes are searched again.
+FrameDecoder::result_t FrameDecoder::scan() {
+    bool failed = false;
+    while (n_) {
+        uint8_t i = 0;
+        while (i < n_ && raw_[i] != SYNC) ++i;
+        drop(i);
+        if (n_ < 2) break;
+
+        const uint8_t len = raw_[1];
+        if (len > MAX_PAYLOAD) { ++errors_; failed = resynced_ = true; drop(1); continue; }
+        const uint8_t total = uint8_t(len + OVERHEAD);
+        if (n_ >= total) {
+            if (valid_at(0, total, true)) { done_ = total; resynced_ = false; return result_t::FRAME; }
+            ++errors_; failed = resynced_ = true; drop(1);
+            continue;
+        }
+
+        // Head still incomplete. Found by a rescan it may be a false SYNC from a damaged
+        // frame, holding real frames behind it: one of those complete and valid wins over
+        // waiting for the head (any such frame right after a drop, else only the one the new
+        // byte completes). A head found by hunting is trusted, no per-byte search.
+        if (!resynced_) break;
+        for (uint8_t j = 1; j + 2 <= n_; ++j) {
+            if (!valid_at(j, n_, !failed)) continue;
+            ++errors_;
+            drop(j);
+            done_     = uint8_t(raw_[1] + OVERHEAD);
+            resynced_ = false;
+            return result_t::FRAME;
+        }
+        break;                                                  // wait for the rest
+    }
+    return failed ? result_t::ERROR : result_t::PENDING;
+}
+
+FrameDecoder::result_t FrameDecoder::resume() {
+    if (done_) { drop(done_); done_ = 0; }
+    return scan();
+}
+
+FrameDecoder::result_t FrameDecoder::push(uint8_t b) {
+    if (done_) { drop(done_); done_ = 0; }
+    if (n_ == 0) {                                              // hunting: nothing to keep
+        if (b != SYNC) return result_t::PENDING;
+        resynced_ = false;
+    }
+    raw_[n_++] = b;                                             // n_ < MAX_FRAME (scan invariant)
+    return scan();
+}
+
+
+// ----------------------------------------
+//              SERIAL LINK
+// ----------------------------------------
+bool SerialLink::poll() {
+    if (dec_.resume() == FrameDecoder::result_t::FRAME) return true;   // left over from a resync
+    for (;;) {
+        const int16_t c = hw_.hw_serial_read();
+        if (c < 0) return false;
+        if (dec_.push(static_cast<uint8_t>(c)) == FrameDecoder::result_t::FRAME) return true;
+    }
+}
+
+dds_status_t SerialLink::send(uint8_t cmd, const uint8_t* payload, uint8_t len) {
+    uint8_t frame[MAX_FRAME];
+    const size_t n = encode(cmd, payload, len, frame, sizeof(frame));
+    if (n == 0) return dds_status_t::DDS_INVALID_PARAM;
+    return hw_.hw_serial_write_bytes(frame, static_cast<uint16_t>(n)) == HWAbstraction::HW_OK
+               ? dds_status_t::DDS_OK : dds_status_t::DDS_HW_ERROR;
+}
+
+dds_status_t SerialLink::reply(uint8_t cmd, dds_status_t status) {
+    if (status == dds_status_t::DDS_OK) return send(CMD_ACK, &cmd, 1);
+    const uint8_t payload[2] = { cmd, static_cast<uint8_t>(static_cast<int8_t>(status)) };
+    return send(CMD_NAK, payload, 2);
+}
+
+} // namespace dds_proto
@@ -6,6 +6,7 @@ ctx.ref_clk_hz       = 100000000;          // Ref_Clk
 ctx.pll_enable       = true;               // PLL on
 ctx.pll_mult         = 20;                 // round(1e9 / 1e8) * 2
 ctx.dac_high_current = false;              // DACCurrentIndex == 0
+ctx.io_update_pulse_us = 10;              // IO_UPDATE high time in us
 
 
 // Expected SPI config FOR 
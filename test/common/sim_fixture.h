@@ -0,0 +1,23 @@
+#pragma once
+#include "boards/native/board_native_sim.h"
+#include "dds/ad9910/ad9910.h"
+
+// Shared by the env:native suites (test_native_sim, test_protocol, test_bench_native)
+
+static const HWAbstraction::spi_config_t kSpiCfg = {
+    2000000u,   // spi_clock_hz (DIV8 at 16 MHz)
+    0,          // bit_order: 0 = MSB first
+    0,          // mode: SPI mode 0
+    0x00        // read_dummy
+};
+
+// GRA & AFCH parameters (see src/main.cpp)
+static AD9910Context make_ctx() {
+    AD9910Context ctx{};
+    ctx.ref_clk_hz       = 100000000;
+    ctx.pll_enable       = true;
+    ctx.pll_mult         = 20;
+    ctx.dac_high_current = false;
+    ctx.allow_overclock  = false;
+    return ctx;
+}
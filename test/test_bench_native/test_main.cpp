@@ -0,0 +1,225 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "boards/native/board_native_sim.h"
+#include "dds/ad9910/ad9910.h"
+#include "common/sim_fixture.h"
+
+// Command
+// pio test -e native_bench -v
+// DDS_BENCH_JSON=bench.json pio test -e native_bench      (also writes the report to a file)
+
+// Cost per driver operation, measured on the emulated chip (boards/native):
+//  - spi_bytes, pin_toggles (pin + port writes), hw_calls (virtual HWAbstraction entries),
+//    cs_assertions and sim_ns (modelled ATmega2560 time) come from NativeSimBoard's counters
+//  - wall_ns is host time, only meaningful against another run on the same machine
+// The report is one JSON document so two runs can be diffed.
+
+// ----------------------------------------
+//               FIXTURE
+// ----------------------------------------
+using bench_clock = std::chrono::steady_clock;
+
+struct bench_result_t {
+    const char* op;
+    uint32_t    iterations;
+    uint64_t    spi_bytes;
+    uint64_t    pin_toggles;
+    uint64_t    hw_calls;
+    uint64_t    cs_assertions;
+    uint64_t    io_updates;
+    uint64_t    sim_ns;
+    uint64_t    wall_ns;
+
+    void add(const NativeSimBoard::sim_stats_t& st) {
+        spi_bytes     += st.spi_bytes;
+        pin_toggles   += uint64_t(st.pin_writes) + st.port_writes;
+        hw_calls      += st.hw_calls;
+        cs_assertions += st.cs_assertions;
+        io_updates    += st.io_updates;
+        sim_ns        += st.time_ns;
+    }
+    double per_op(uint64_t v) const { return iterations ? double(v) / iterations : 0.0; }
+};
+
+static bench_result_t g_results[16];
+static uint8_t        g_count = 0;
+
+static bench_result_t& new_result(const char* op, uint32_t iterations) {
+    bench_result_t& r = g_results[g_count++];
+    r = bench_result_t{};
+    r.op = op;
+    r.iterations = iterations;
+    return r;
+}
+
+// Runs op(i) iterations times against one initialized device, counters reset first
+template<typename Op>
+static bench_result_t& run(const char* op_name, NativeSimBoard& sim, uint32_t iterations, Op op) {
+    bench_result_t& r = new_result(op_name, iterations);
+    sim.sim_reset_stats();
+    const auto t0 = bench_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) op(i);
+    r.wall_ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - t0).count());
+    r.add(sim.sim_stats());
+    return r;
+}
+
+static void emit_json(FILE* f) {
+    const auto& cm = NativeSimBoard::kMegaCostModel;
+    fprintf(f, "{\n  \"suite\": \"test_bench_native\",\n");
+    fprintf(f, "  \"cost_model\": { \"cpu_hz\": %u, \"pin_write_cycles\": %u, \"spi_call_cycles\": %u, \"spi_byte_cycles\": %u },\n",
+            unsigned(cm.cpu_hz), unsigned(cm.pin_write_cycles), unsigned(cm.spi_call_cycles), unsigned(cm.spi_byte_cycles));
+    fprintf(f, "  \"spi_clock_hz\": %u,\n", unsigned(kSpiCfg.spi_clock_hz));
+    fprintf(f, "  \"ftw_batch_kernel\": \"%s\",\n  \"results\": [\n", ad9910_math::ftw_batch_kernel());
+    for (uint8_t i = 0; i < g_count; i++) {
+        const bench_result_t& r = g_results[i];
+        fprintf(f, "    { \"op\": \"%s\", \"iterations\": %u, \"spi_bytes\": %.2f, \"pin_toggles\": %.2f, "
+                   "\"hw_calls\": %.2f, \"cs_assertions\": %.2f, \"io_updates\": %.2f, \"sim_ns\": %.1f, \"wall_ns\": %.1f }%s\n",
+                r.op, unsigned(r.iterations), r.per_op(r.spi_bytes), r.per_op(r.pin_toggles),
+                r.per_op(r.hw_calls), r.per_op(r.cs_assertions), r.per_op(r.io_updates),
+                r.per_op(r.sim_ns), r.per_op(r.wall_ns), (i + 1 < g_count) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+
+// ----------------------------------------
+//               BENCHMARKS
+// ----------------------------------------
+
+// --- BENCH : dds_init on a fresh chip (reset sequence, PLL setup, 4 registers)
+void bench_dds_init() {
+    constexpr uint32_t N = 200;
+    bench_result_t& r = new_result("dds_init", N);
+    for (uint32_t i = 0; i < N; i++) {
+        NativeSimBoard sim;
+        AD9910 dds(sim, kSpiCfg, make_ctx());
+        const auto t0 = bench_clock::now();
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+        r.wall_ns += uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - t0).count());
+        r.add(sim.sim_stats());
+    }
+}
+
+// --- BENCH : Hz → FTW, pure arithmetic (no HW access expected)
+void bench_dds_freq_ftw() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    volatile uint32_t sink = 0;
+    const auto& r = run("dds_freq_ftw", sim, 200000, [&](uint32_t i) { sink = sink + dds.dds_freq_ftw(1000000u + i); });
+    TEST_ASSERT_EQUAL_UINT64(0, r.hw_calls);
+}
+
+// --- BENCH : buffered-mode list of 512 frequencies → FTWs (one iteration = one list)
+void bench_dds_freq_ftw_batch() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    static uint32_t freqs[512], ftws[512];
+    for (uint32_t i = 0; i < 512; i++) freqs[i] = 1000000u + 1733u * i;
+    volatile uint32_t sink = 0;
+    run("dds_freq_ftw_batch_512", sim, 2000, [&](uint32_t i) {
+        freqs[i & 511u] += 1u;
+        dds.dds_freq_ftw_batch(freqs, ftws, 512);
+        sink = sink + ftws[i & 511u]; });
+}
+
+// --- BENCH : host-side table compilation, 10^6 entries per iteration: per-entry calls vs batch
+static constexpr uint32_t kTableLen = 1000000u;
+
+void bench_ftw_table_1m() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    static uint32_t freqs[kTableLen], ftw_loop[kTableLen], ftw_batch[kTableLen];
+    for (uint32_t i = 0; i < kTableLen; i++) freqs[i] = 1000000u + 397u * i;
+
+    run("ftw_table_1m_loop", sim, 10, [&](uint32_t) {
+        for (uint32_t i = 0; i < kTableLen; i++) ftw_loop[i] = dds.dds_freq_ftw(freqs[i]); });
+    run("ftw_table_1m_batch", sim, 10, [&](uint32_t) { dds.dds_freq_ftw_batch(freqs, ftw_batch, kTableLen); });
+    for (uint32_t i = 0; i < kTableLen; i++) TEST_ASSERT_EQUAL_HEX32(ftw_loop[i], ftw_batch[i]);
+}
+
+// --- BENCH : sweep with a new stop frequency each time (nothing skipped by the cache)
+void bench_dds_freq_sweep() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    const auto& r = run("dds_freq_sweep", sim, 2000, [&](uint32_t i) {
+        dds.dds_freq_sweep(1000000u, 2000000u + 1000u * i, 10u, SweepTimeFormat::Milliseconds, (i & 1u) != 0); });
+    TEST_ASSERT_EQUAL_UINT64(2000, r.io_updates);
+}
+
+// --- BENCH : same sweep repeated (register cache hits)
+void bench_dds_freq_sweep_repeat() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    run("dds_freq_sweep_repeat", sim, 2000, [&](uint32_t) {
+        dds.dds_freq_sweep(1000000u, 2000000u, 10u, SweepTimeFormat::Milliseconds, true); });
+}
+
+// --- BENCH : DRG ramp from raw words
+void bench_dds_digital_ramp() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    const uint32_t f0 = dds.dds_freq_ftw(1000000u);
+    const uint32_t f1 = dds.dds_freq_ftw(5000000u);
+    run("dds_digital_ramp", sim, 2000, [&](uint32_t i) { dds.dds_digital_ramp(f0, f1 + i, 1000u, 10u, true); });
+}
+
+// --- BENCH : PROFILE[2:0] switching (pins only)
+void bench_profile_switch() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    const auto& r = run("profile_switch", sim, 20000, [&](uint32_t i) { dds.dds_profile_select(uint8_t(i & 7u)); });
+    TEST_ASSERT_EQUAL_UINT64(0, r.spi_bytes);
+}
+
+// --- BENCH : single tone update through a profile register (write + IO_UPDATE + select)
+void bench_dds_freq_out() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    run("dds_freq_out", sim, 5000, [&](uint32_t i) { dds.dds_freq_out<ad9910_reg::PROFILE0>(1000000u + i, 0); });
+}
+
+// --- Report
+void bench_report() {
+    emit_json(stdout);
+    if (const char* path = std::getenv("DDS_BENCH_JSON")) {
+        FILE* f = std::fopen(path, "w");
+        TEST_ASSERT_NOT_NULL(f);
+        emit_json(f);
+        std::fclose(f);
+    }
+}
+
+
+// ----------------------------------------
+//                MAIN BODY
+// ----------------------------------------
+void setUp()   {}
+void tearDown(){}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_dds_init);
+    RUN_TEST(bench_dds_freq_ftw);
+    RUN_TEST(bench_dds_freq_ftw_batch);
+    RUN_TEST(bench_ftw_table_1m);
+    RUN_TEST(bench_dds_freq_sweep);
+    RUN_TEST(bench_dds_freq_sweep_repeat);
+    RUN_TEST(bench_dds_digital_ramp);
+    RUN_TEST(bench_profile_switch);
+    RUN_TEST(bench_dds_freq_out);
+    RUN_TEST(bench_report);
+
+    return UNITY_END();
+}
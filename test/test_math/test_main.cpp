@@ -0,0 +1,357 @@
+#include <unity.h>
+#include <cmath>
+#include "dds/ad9910/ad9910_math.h"
+
+// Command
+// pio test -e native -f test_math
+
+// The integer kernels against the floating point code they replace (kept here as the
+// reference), over the whole input domain where it is enumerable and a dense grid where not.
+
+// ----------------------------------------
+//           FLOATING POINT REFERENCE
+// ----------------------------------------
+static uint16_t ref_asf(int16_t ampl_db) {
+    if (ampl_db <= -85) { return 0;         }
+    if (ampl_db >= 0)   { return 0x3FFFu;   }
+    const float exponent = (static_cast<float>(ampl_db) + 84.288f) * (1.0f / 20.0f);
+    uint32_t asf_u = static_cast<uint32_t>(std::pow(10.0f, exponent));
+    if (asf_u > 0x3FFFu) { asf_u = 0x3FFFu;}
+    return static_cast<uint16_t>(asf_u);
+}
+
+static void ref_drg(uint32_t delta_ftw, uint64_t desired_ns, uint64_t sysclk,
+                    uint32_t& ftw_step, uint16_t& step_rate) {
+    const long double core_ghz = static_cast<long double>(sysclk) / 1.0e9L;
+    ftw_step  = 1u;
+    step_rate = 1u;
+    const long double base_ns = (4.0L / core_ghz) * static_cast<long double>(delta_ftw);
+    if (base_ns < desired_ns) {
+        long double mult = desired_ns / base_ns;
+        uint32_t sr = static_cast<uint32_t>(std::llround(std::fmin(mult, 1e9L)));
+        if (sr == 0)     sr = 1;
+        if (sr > 0xFFFF) sr = 0xFFFF;
+        step_rate = static_cast<uint16_t>(sr);
+    } else if (base_ns > desired_ns) {
+        long double mult = base_ns / desired_ns;
+        uint32_t fs = static_cast<uint32_t>(std::llround(std::fmin(mult, 4294967295.0L)));
+        if (fs == 0)         fs = 1;
+        if (fs > delta_ftw)  fs = delta_ftw;
+        ftw_step = fs;
+    }
+}
+
+static void ref_best_step_rate(uint64_t sysclk, uint32_t f_mod_hz, uint16_t& step, uint64_t& step_rate) {
+    const double t_step      = 1.0 / (static_cast<double>(f_mod_hz) * static_cast<double>(step));
+    const double f_step_rate = (t_step * static_cast<double>(sysclk)) / 4.0;
+    step_rate = static_cast<uint64_t>(std::ceil(f_step_rate));
+    double s = static_cast<double>(sysclk) / (4.0 * static_cast<double>(step_rate) * static_cast<double>(f_mod_hz));
+    if (s > 65535.0) s = 65535.0;
+    step = static_cast<uint16_t>(s);
+}
+
+static const uint64_t kSysclks[] = { 1000000000ull, 999999999ull, 800000000ull, 500000000ull,
+                                     420000000ull, 100000000ull, 25000000ull };
+
+
+// ----------------------------------------
+//               128-BIT
+// ----------------------------------------
+
+// --- TEST : mul / div against __int128
+void test_u128_mul_div() {
+    const uint64_t vals[] = { 0, 1, 3, 0xFFFFFFFFull, 0x100000000ull, 1000000007ull,
+                              0x123456789ABCDEFull, 0x7FFFFFFFFFFFFFFFull, UINT64_MAX };
+    for (uint64_t a : vals) for (uint64_t b : vals) {
+        const unsigned __int128 p = (unsigned __int128)a * b;
+        const auto m = ad9910_math::mul_u64(a, b);
+        TEST_ASSERT_EQUAL_HEX64(uint64_t(p >> 64), m.hi);
+        TEST_ASSERT_EQUAL_HEX64(uint64_t(p), m.lo);
+        for (uint64_t d : vals) {
+            if (d == 0) continue;
+            uint64_t r = 0;
+            const uint64_t q = ad9910_math::div_u128(m, d, &r);
+            const unsigned __int128 qq = p / d;
+            if (qq > UINT64_MAX) { TEST_ASSERT_EQUAL_HEX64(UINT64_MAX, q); continue; }
+            TEST_ASSERT_EQUAL_HEX64(uint64_t(qq), q);
+            TEST_ASSERT_EQUAL_HEX64(uint64_t(p % d), r);
+        }
+    }
+}
+
+
+// ----------------------------------------
+//               FREQUENCY
+// ----------------------------------------
+
+// --- TEST : FTW = round(f × 2^32 / sysclk), saturation
+void test_ftw_from_hz() {
+    for (uint64_t sys : kSysclks) {
+        for (uint32_t f = 1; f < 0xFFFFFFFFu - 7919u * 65536u; f += 7919u * 65536u + 13u) {
+            const uint32_t got = ad9910_math::ftw_from_hz(f, uint32_t(sys));
+            if (f >= sys) { TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFFu, got); continue; }
+            const unsigned __int128 ref = (((unsigned __int128)f << 32) + sys / 2u) / sys;
+            TEST_ASSERT_EQUAL_HEX32(uint32_t(ref), got);
+        }
+    }
+    TEST_ASSERT_EQUAL_HEX32(0, ad9910_math::ftw_from_hz(0, 1000000000u));
+    TEST_ASSERT_EQUAL_HEX32(0, ad9910_math::ftw_from_hz(1000, 0));
+}
+
+
+// --- TEST : reciprocal multiply-shift = division, scalar and batch
+void test_ftw_recip_exact() {
+    const uint32_t sysclks[] = { 1u, 2u, 3u, 7u, 1000u, 25000000u, 100000000u, 419999999u,
+                                 500000000u, 999999999u, 1000000000u, (1u << 30) - 1u };
+    uint32_t lcg = 12345u;
+    for (uint32_t sys : sysclks) {
+        const auto rc = ad9910_math::ftw_recip(sys);
+        TEST_ASSERT_TRUE(rc.r != 0);
+        // Edges: 0, 1, around sysclk/2 (the ties), sysclk - 1, sysclk, above
+        const uint32_t edges[] = { 0u, 1u, sys / 2u, sys / 2u + 1u, sys - 1u, sys, sys + 1u, 0xFFFFFFFFu };
+        for (uint32_t f : edges)
+            TEST_ASSERT_EQUAL_HEX32(ad9910_math::ftw_from_hz(f, sys), ad9910_math::ftw_from_hz(f, rc));
+        for (uint32_t i = 0; i < 20000; i++) {
+            lcg = lcg * 1664525u + 1013904223u;
+            const uint32_t f = lcg % sys;
+            TEST_ASSERT_EQUAL_HEX32(ad9910_math::ftw_from_hz(f, sys), ad9910_math::ftw_from_hz(f, rc));
+        }
+    }
+    TEST_ASSERT_EQUAL_HEX64(0, ad9910_math::ftw_recip(0).r);
+    TEST_ASSERT_EQUAL_HEX64(0, ad9910_math::ftw_recip(1u << 30).r);     // falls back to the division
+    TEST_ASSERT_EQUAL_HEX32(ad9910_math::ftw_from_hz(12345678u, 1u << 30),
+                            ad9910_math::ftw_from_hz(12345678u, ad9910_math::ftw_recip(1u << 30)));
+
+    uint32_t f[300], ftw[300];
+    for (uint32_t i = 0; i < 300; i++) f[i] = 1000000u + 3333331u * i;
+    const auto rc = ad9910_math::ftw_recip(1000000000u);
+    ad9910_math::ftw_from_hz_batch(f, ftw, 300, rc);
+    for (uint32_t i = 0; i < 300; i++) TEST_ASSERT_EQUAL_HEX32(ad9910_math::ftw_from_hz(f[i], 1000000000u), ftw[i]);
+}
+
+
+// --- TEST : vector kernel (whichever this host has) = scalar, odd lengths and saturation included
+void test_ftw_batch_simd_matches_scalar() {
+    static uint32_t f[1031], got[1031];
+    const uint32_t sysclks[] = { 50000u, 25000000u, 420000000u, 999999999u, 1000000000u, (1u << 30) - 1u };
+    uint32_t lcg = 777u;
+    for (uint32_t sys : sysclks) {
+        const auto rc = ad9910_math::ftw_recip(sys);
+        for (uint32_t i = 0; i < 1031; i++) {
+            lcg = lcg * 1664525u + 1013904223u;
+            switch (i % 11) {
+                case 0:  f[i] = 0;                  break;
+                case 1:  f[i] = sys;                break;     // saturates
+                case 2:  f[i] = lcg | 0x80000000u;  break;     // > sysclk, sign bit set
+                case 3:  f[i] = sys - 1u;           break;
+                case 4:  f[i] = sys / 2u;           break;
+                default: f[i] = lcg % sys;          break;
+            }
+        }
+        for (size_t n : { size_t(0), size_t(1), size_t(3), size_t(4), size_t(7), size_t(8), size_t(9), size_t(1031) }) {
+            ad9910_math::ftw_from_hz_batch(f, got, n, rc);
+            for (size_t i = 0; i < n; i++)
+                TEST_ASSERT_EQUAL_HEX32(ad9910_math::ftw_from_hz(f[i], sys), got[i]);
+        }
+    }
+    TEST_MESSAGE(ad9910_math::ftw_batch_kernel());
+}
+
+
+// ----------------------------------------
+//               AMPLITUDE
+// ----------------------------------------
+
+// --- TEST : every int16 dB value matches powf
+void test_asf_from_db_whole_domain() {
+    for (int32_t db = INT16_MIN; db <= INT16_MAX; db++)
+        TEST_ASSERT_EQUAL_UINT16(ref_asf(int16_t(db)), ad9910_math::asf_from_db(int16_t(db)));
+}
+
+// --- TEST : 0.01 dB table = floor of the exact value, monotonic, 0 / 0x3FFF ends
+void test_asf_from_cdb_whole_domain() {
+    uint16_t prev = 0;
+    for (int32_t cdb = -9000; cdb <= 100; cdb++) {
+        const uint16_t got = ad9910_math::asf_from_cdb(cdb);
+        long double exact = std::pow(10.0L, (cdb / 100.0L + 84.288L) / 20.0L);
+        if (exact > 16383.0L) exact = 16383.0L;
+        TEST_ASSERT_EQUAL_UINT16(uint16_t(exact), got);
+        TEST_ASSERT_TRUE(got >= prev);
+        prev = got;
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, ad9910_math::asf_from_cdb(INT32_MIN));
+    TEST_ASSERT_EQUAL_UINT16(0x3FFFu, ad9910_math::asf_from_cdb(INT32_MAX));
+}
+
+
+// ----------------------------------------
+//               DIGITAL RAMP
+// ----------------------------------------
+
+// --- TEST : DRG step / rate over sysclk × delta × duration grid
+void test_drg_step_rate_grid() {
+    uint32_t checked = 0;
+    for (uint64_t sys : kSysclks) {
+        for (uint64_t delta = 1; delta <= 0xFFFFFFFFull; delta = delta * 3 + 1) {
+            for (uint64_t ns = 1; ns < 4000000000000000000ull; ns = ns * 7 / 3 + 1) {
+                uint32_t fs_ref, fs; uint16_t sr_ref, sr;
+                ref_drg(uint32_t(delta), ns, sys, fs_ref, sr_ref);
+                TEST_ASSERT_TRUE(ad9910_math::drg_step_rate(uint32_t(delta), ns, sys, fs, sr));
+                TEST_ASSERT_EQUAL_UINT32(fs_ref, fs);
+                TEST_ASSERT_EQUAL_UINT16(sr_ref, sr);
+                ++checked;
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(checked > 5000);
+    uint32_t fs; uint16_t sr;
+    TEST_ASSERT_FALSE(ad9910_math::drg_step_rate(0, 1000, 1000000000ull, fs, sr));
+    TEST_ASSERT_FALSE(ad9910_math::drg_step_rate(1000, 0, 1000000000ull, fs, sr));
+}
+
+// --- TEST : drg_fit hits the exact tick count at least as well as drg_step_rate
+void test_drg_fit_grid() {
+    uint32_t checked = 0, better = 0;
+    for (uint64_t sys : kSysclks) {
+        for (uint64_t delta = 1; delta <= 0xFFFFFFFFull; delta = delta * 5 + 3) {
+            for (uint64_t ns = 10; ns < 100000000000ull; ns = ns * 9 / 4 + 7) {
+                const uint64_t want = ad9910_math::drg_ticks_from_ns(ns, sys);
+                if (want == 0) continue;
+                uint32_t fs; uint16_t sr;
+                ad9910_math::drg_step_rate(uint32_t(delta), ns, sys, fs, sr);
+                const uint64_t t_old   = ((delta + fs - 1) / fs) * sr;
+                const uint64_t err_old = t_old > want ? t_old - want : want - t_old;
+
+                const uint64_t t_new   = ad9910_math::drg_fit(uint32_t(delta), want, fs, sr);
+                TEST_ASSERT_TRUE(fs >= 1 && fs <= delta && sr >= 1);
+                TEST_ASSERT_EQUAL_UINT64(((delta + fs - 1) / fs) * sr, t_new);
+                const uint64_t err_new = t_new > want ? t_new - want : want - t_new;
+                TEST_ASSERT_LESS_OR_EQUAL_UINT64(err_old, err_new);
+                if (err_new < err_old) ++better;
+                ++checked;
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(checked > 2000);
+    TEST_ASSERT_TRUE(better > checked / 4);
+
+    uint32_t fs; uint16_t sr;
+    TEST_ASSERT_EQUAL_UINT64(0, ad9910_math::drg_fit(0, 1000, fs, sr));
+    TEST_ASSERT_EQUAL_UINT64(250, ad9910_math::drg_ticks_from_ns(1000, 1000000000ull));
+    TEST_ASSERT_EQUAL_UINT64(1000, ad9910_math::drg_ns_from_ticks(250, 1000000000ull));
+}
+
+// Reference for drg_solve: every step size, each with its two best rates (the error is
+// convex in the rate, so floor / ceil of ticks / n is exhaustive for a given step)
+static uint64_t brute_drg_err(uint32_t delta, uint64_t ticks) {
+    uint64_t best = UINT64_MAX;
+    for (uint64_t st = 1; st <= delta; ++st) {
+        const uint64_t n = (delta + st - 1) / st;
+        for (uint64_t r = ticks / n; r <= ticks / n + 1; ++r) {
+            const uint64_t rr  = r < 1 ? 1 : (r > 0xFFFFu ? 0xFFFFu : r);
+            const uint64_t t   = n * rr;
+            const uint64_t err = t > ticks ? t - ticks : ticks - t;
+            if (err < best) best = err;
+        }
+    }
+    return best;
+}
+
+// --- TEST : drg_solve finds the brute-force optimum
+void test_drg_solve_brute_force() {
+    ad9910_math::drg_solution_t sol;
+    uint32_t checked = 0;
+
+    // Full 2-D brute force on small ramps
+    for (uint32_t delta = 1; delta <= 24; delta += 1) {
+        for (uint64_t ticks = 1; ticks < 3000000ull; ticks = ticks * 5 + 3) {
+            uint64_t best = UINT64_MAX;
+            for (uint64_t st = 1; st <= delta; ++st)
+                for (uint64_t r = 1; r <= 0xFFFFu; ++r) {
+                    const uint64_t t = ((delta + st - 1) / st) * r;
+                    const uint64_t e = t > ticks ? t - ticks : ticks - t;
+                    if (e < best) best = e;
+                }
+            TEST_ASSERT_TRUE(ad9910_math::drg_solve(delta, ticks, sol));
+            const uint64_t e = sol.ticks > ticks ? sol.ticks - ticks : ticks - sol.ticks;
+            TEST_ASSERT_EQUAL_UINT64(best, e);
+            ++checked;
+        }
+    }
+
+    // Every step size on wider ramps, pseudo-random durations
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 300; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        const uint32_t delta = 1u + uint32_t(x % 60000u);
+        const uint64_t ticks = 1u + (x >> 20) % (uint64_t(delta) * 70000u);
+        TEST_ASSERT_TRUE(ad9910_math::drg_solve(delta, ticks, sol));
+
+        TEST_ASSERT_TRUE(sol.ftw_step >= 1 && sol.ftw_step <= delta && sol.step_rate >= 1);
+        TEST_ASSERT_EQUAL_UINT32((uint64_t(delta) + sol.ftw_step - 1) / sol.ftw_step, sol.steps);
+        TEST_ASSERT_EQUAL_UINT64(uint64_t(sol.steps) * sol.step_rate, sol.ticks);
+        TEST_ASSERT_EQUAL_UINT32(delta, (sol.steps - 1) * sol.ftw_step + sol.last_step);
+        TEST_ASSERT_TRUE(sol.last_step >= 1 && sol.last_step <= sol.ftw_step);
+
+        const uint64_t e = sol.ticks > ticks ? sol.ticks - ticks : ticks - sol.ticks;
+        TEST_ASSERT_EQUAL_UINT64(brute_drg_err(delta, ticks), e);
+
+        uint32_t fs; uint16_t sr;                                   // never worse than the bounded fit
+        const uint64_t tf = ad9910_math::drg_fit(delta, ticks, fs, sr);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT64(tf > ticks ? tf - ticks : ticks - tf, e);
+        ++checked;
+    }
+    TEST_ASSERT_TRUE(checked > 500);
+    TEST_ASSERT_FALSE(ad9910_math::drg_solve(0, 100, sol));
+}
+
+// --- TEST : calc_best_step_rate kernel over sysclk × f_mod × step
+void test_best_step_rate_grid() {
+    uint32_t inexact = 0;
+    for (uint64_t sys : kSysclks) {
+        for (uint64_t f = 1; f <= 0xFFFFFFFFull; f = f * 5 / 2 + 1) {
+            for (uint32_t st = 1; st <= 0xFFFFu; st = st * 3 + 1) {
+                uint16_t s_ref = uint16_t(st), s = uint16_t(st);
+                uint64_t r_ref = 0, r = 0;
+                ref_best_step_rate(sys, uint32_t(f), s_ref, r_ref);
+                TEST_ASSERT_TRUE(ad9910_math::best_step_rate(sys, uint32_t(f), s, r));
+                if (r_ref != r) {
+                    // double's 1/(f × step) × sysclk lands just above an exact integer and
+                    // ceil() adds one; the integer kernel returns the exact ceiling
+                    const uint64_t den = 4ull * f * st;
+                    TEST_ASSERT_EQUAL_UINT64(0, sys % den);
+                    TEST_ASSERT_EQUAL_UINT64(sys / den + 1u, r_ref);
+                    TEST_ASSERT_EQUAL_UINT64(sys / den, r);
+                    ++inexact;
+                    continue;
+                }
+                TEST_ASSERT_EQUAL_UINT16(s_ref, s);
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(inexact < 16);
+}
+
+
+// ----------------------------------------
+//                MAIN BODY
+// ----------------------------------------
+void setUp()   {}
+void tearDown(){}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_u128_mul_div);
+    RUN_TEST(test_ftw_from_hz);
+    RUN_TEST(test_ftw_recip_exact);
+    RUN_TEST(test_ftw_batch_simd_matches_scalar);
+    RUN_TEST(test_asf_from_db_whole_domain);
+    RUN_TEST(test_asf_from_cdb_whole_domain);
+    RUN_TEST(test_drg_step_rate_grid);
+    RUN_TEST(test_drg_fit_grid);
+    RUN_TEST(test_drg_solve_brute_force);
+    RUN_TEST(test_best_step_rate_grid);
+
+    return UNITY_END();
+}
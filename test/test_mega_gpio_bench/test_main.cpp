@@ -0,0 +1,112 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "boards/arduino/models/board_arduino_mega.h"
+#include "dds/ad9910/ad9910_pins.h"
+
+// Command
+// pio test -e test_mega_gpio_bench
+
+// Cycles per toggle: Arduino core digitalWrite vs ArduinoMega direct port write.
+// Timer1 runs at F_CPU (no prescaler), so one tick = one CPU cycle.
+
+ArduinoMega mega;
+
+static constexpr uint16_t kToggles = 200;   // keeps the slow path under 65535 ticks
+
+// ----------------------------------------
+//               HELPERS
+// ----------------------------------------
+static void timer1_start() {
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1  = 0;
+    TCCR1B = _BV(CS10);                     // clk/1
+}
+
+static uint16_t timer1_stop() {
+    const uint16_t t = TCNT1;
+    TCCR1B = 0;
+    return t;
+}
+
+static void report(const char* name, uint16_t ticks) {
+    char line[64];
+    snprintf(line, sizeof(line), "%s: %u cycles / %u writes = %u.%02u",
+             name, ticks, kToggles, ticks / kToggles, (ticks % kToggles) * 100u / kToggles);
+    TEST_MESSAGE(line);
+}
+
+static uint16_t bench_digital_write(uint8_t ix) {
+    const uint8_t sreg = SREG;
+    cli();
+    timer1_start();
+    for (uint16_t i = 0; i < kToggles; i += 2) {
+        ::digitalWrite(ix, HIGH);
+        ::digitalWrite(ix, LOW);
+    }
+    const uint16_t t = timer1_stop();
+    SREG = sreg;
+    return t;
+}
+
+static uint16_t bench_hw_pin_write(HWAbstraction& hw, uint8_t ix) {
+    const uint8_t sreg = SREG;
+    cli();
+    timer1_start();
+    for (uint16_t i = 0; i < kToggles; i += 2) {
+        hw.hw_pin_write(ix, HWAbstraction::HW_PIN_HIGH);   // through the vtable, as the driver calls it
+        hw.hw_pin_write(ix, HWAbstraction::HW_PIN_LOW);
+    }
+    const uint16_t t = timer1_stop();
+    SREG = sreg;
+    return t;
+}
+
+
+// ----------------------------------------
+//                TESTS
+// ----------------------------------------
+
+// --- TEST : fast path drives the same pin level as digitalWrite
+void test_fast_write_levels() {
+    const uint8_t ix = mega.pin_to_index(pin(DdsPin::IO_UPDATE));
+    TEST_ASSERT_EQUAL(HWAbstraction::HW_OK, mega.hw_pin_attach(pin(DdsPin::IO_UPDATE)));
+
+    HWAbstraction::hw_pin_value_t v;
+    mega.hw_pin_write(ix, HWAbstraction::HW_PIN_HIGH);
+    TEST_ASSERT_EQUAL(HIGH, ::digitalRead(ix));
+    TEST_ASSERT_EQUAL(HWAbstraction::HW_OK, mega.hw_pin_read(ix, &v));
+    TEST_ASSERT_EQUAL(HWAbstraction::HW_PIN_HIGH, v);
+
+    mega.hw_pin_toggle(ix);
+    TEST_ASSERT_EQUAL(LOW, ::digitalRead(ix));
+}
+
+// --- TEST : cycles per write, digitalWrite vs direct port
+void test_bench_cycles_per_write() {
+    const uint8_t ix = mega.pin_to_index(pin(DdsPin::IO_UPDATE));   // PH3: outside sbi/cbi range
+    TEST_ASSERT_EQUAL(HWAbstraction::HW_OK, mega.hw_pin_attach(pin(DdsPin::IO_UPDATE)));
+
+    const uint16_t slow = bench_digital_write(ix);
+    const uint16_t fast = bench_hw_pin_write(mega, ix);
+    report("digitalWrite ", slow);
+    report("hw_pin_write ", fast);
+    TEST_ASSERT_LESS_THAN_UINT16(slow, fast);
+}
+
+
+// ----------------------------------------
+//                MAIN BODY
+// ----------------------------------------
+void setUp()   {}
+void tearDown(){}
+
+void setup() {
+    delay(2000);    // let serial settle
+    UNITY_BEGIN();
+    RUN_TEST(test_fast_write_levels);
+    RUN_TEST(test_bench_cycles_per_write);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,1215 @@
+#include <unity.h>
+#include "boards/native/board_native_sim.h"
+#include "dds/ad9910/ad9910.h"
+#include "common/sim_fixture.h"
+#include "dds/ad9910/ad9910_profile_sequencer.h"
+#include "dds/ad9910/ad9910_sweep_plan.h"
+#include "dds/ad9910/ad9910_array.h"
+
+// Command
+// pio test -e native -f test_native_sim
+
+// ----------------------------------------
+//               FIXTURE
+// ----------------------------------------
+static uint8_t ix(DdsPin p) { return static_cast<uint8_t>(pin(p).port * 8u + pin(p).pin); }
+
+// Raw frame as AD9910::dds_reg_write clocks it: CS low, header, payload, CS high
+static void raw_write(NativeSimBoard& sim, uint8_t addr, const uint8_t* data, uint16_t len) {
+    sim.hw_pin_write(ix(DdsPin::SPI_CS), HWAbstraction::HW_PIN_LOW);
+    uint8_t header = addr & 0x7Fu;
+    sim.hw_spi_write(&header, 1);
+    sim.hw_spi_write(data, len);
+    sim.hw_pin_write(ix(DdsPin::SPI_CS), HWAbstraction::HW_PIN_HIGH);
+}
+
+static void io_update(NativeSimBoard& sim) {
+    sim.hw_pin_write(ix(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_HIGH);
+    sim.hw_pin_write(ix(DdsPin::IO_UPDATE), HWAbstraction::HW_PIN_LOW);
+}
+
+
+// ----------------------------------------
+//               DECODER
+// ----------------------------------------
+
+// --- TEST : power-on defaults
+void test_sim_power_on_defaults() {
+    NativeSimBoard sim;
+    TEST_ASSERT_EQUAL_HEX32(0x00000000u, sim.sim_active(ad9910_reg::Reg::CFR1));
+    TEST_ASSERT_EQUAL_HEX32(0x00400820u, sim.sim_active(ad9910_reg::Reg::CFR2));
+    TEST_ASSERT_EQUAL_HEX32(0x1F3F4000u, sim.sim_active(ad9910_reg::Reg::CFR3));
+    TEST_ASSERT_EQUAL_HEX32(0x0000007Fu, sim.sim_active(ad9910_reg::Reg::AUX_DAC));
+}
+
+// --- TEST : writes land in the staged bank, IO_UPDATE makes them active
+void test_sim_staged_then_active() {
+    NativeSimBoard sim;
+    sim.hw_spi_init(kSpiCfg);
+
+    const uint8_t cfr1[4] = { 0x00, 0x00, 0x40, 0x02 };
+    raw_write(sim, 0x00, cfr1, 4);
+    TEST_ASSERT_EQUAL_HEX32(0x00004002u, sim.sim_staged(ad9910_reg::Reg::CFR1));
+    TEST_ASSERT_EQUAL_HEX32(0x00000000u, sim.sim_active(ad9910_reg::Reg::CFR1));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().frames);
+
+    io_update(sim);
+    TEST_ASSERT_EQUAL_HEX32(0x00004002u, sim.sim_active(ad9910_reg::Reg::CFR1));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_UINT32(5, sim.sim_stats().last_update_bytes);
+}
+
+// --- TEST : several registers in one CS assertion (serial I/O cycle restarts after each register)
+void test_sim_back_to_back_frames() {
+    NativeSimBoard sim;
+    sim.hw_spi_init(kSpiCfg);
+
+    const uint8_t stream[] = {  0x08, 0x12, 0x34,                   // POW (2 bytes)
+                                0x07, 0xDE, 0xAD, 0xBE, 0xEF };     // FTW (4 bytes)
+    sim.hw_pin_write(ix(DdsPin::SPI_CS), HWAbstraction::HW_PIN_LOW);
+    sim.hw_spi_write(stream, sizeof(stream));
+    sim.hw_pin_write(ix(DdsPin::SPI_CS), HWAbstraction::HW_PIN_HIGH);
+    io_update(sim);
+
+    TEST_ASSERT_EQUAL_HEX16(0x1234u,     sim.sim_active(ad9910_reg::Reg::POW));
+    TEST_ASSERT_EQUAL_HEX32(0xDEADBEEFu, sim.sim_active(ad9910_reg::Reg::FTW));
+    TEST_ASSERT_EQUAL_UINT32(2, sim.sim_stats().frames);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().cs_assertions);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().protocol_errors);
+}
+
+// --- TEST : read instruction returns the active register, MSB first
+void test_sim_register_read() {
+    NativeSimBoard sim;
+    sim.hw_spi_init(kSpiCfg);
+
+    uint8_t header = 0x02 | ad9910_reg::SPI_READ;      // CFR3
+    uint8_t buf[4] = {};
+    sim.hw_pin_write(ix(DdsPin::SPI_CS), HWAbstraction::HW_PIN_LOW);
+    sim.hw_spi_write(&header, 1);
+    sim.hw_spi_read(buf, 4);
+    sim.hw_pin_write(ix(DdsPin::SPI_CS), HWAbstraction::HW_PIN_HIGH);
+
+    const uint8_t exp[4] = { 0x1F, 0x3F, 0x40, 0x00 };
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(exp, buf, 4);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().reads);
+}
+
+// --- TEST : CS released mid-register is flagged, MASTER_RESET restores defaults
+void test_sim_protocol_error_and_reset() {
+    NativeSimBoard sim;
+    sim.hw_spi_init(kSpiCfg);
+
+    const uint8_t partial[2] = { 0xAA, 0xBB };
+    raw_write(sim, 0x07, partial, 2);                   // FTW needs 4 bytes
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().protocol_errors);
+
+    const uint8_t fsc[4] = { 0, 0, 0, 0xFF };
+    raw_write(sim, 0x03, fsc, 4);
+    io_update(sim);
+    TEST_ASSERT_EQUAL_HEX32(0xFFu, sim.sim_active(ad9910_reg::Reg::AUX_DAC));
+
+    sim.hw_pin_write(ix(DdsPin::MASTER_RESET), HWAbstraction::HW_PIN_HIGH);
+    sim.hw_pin_write(ix(DdsPin::MASTER_RESET), HWAbstraction::HW_PIN_LOW);
+    TEST_ASSERT_EQUAL_HEX32(0x7Fu, sim.sim_active(ad9910_reg::Reg::AUX_DAC));
+}
+
+// --- TEST : masked port write changes several pins in one instant
+void test_sim_port_write_masked() {
+    NativeSimBoard sim;
+    uint8_t port_1, port_2; uint32_t m1, m2;
+    TEST_ASSERT_TRUE(sim.hw_pin_port(ix(DdsPin::PROFILE1), &port_1, &m1));
+    TEST_ASSERT_TRUE(sim.hw_pin_port(ix(DdsPin::PROFILE2), &port_2, &m2));
+    TEST_ASSERT_EQUAL_UINT8(port_1, port_2);                                  // PH1 / PH0 on the Mega map
+
+    TEST_ASSERT_EQUAL(HWAbstraction::HW_OK, sim.hw_port_write_masked(port_1, m1 | m2, m1 | m2));
+    TEST_ASSERT_EQUAL_UINT8(6, sim.sim_profile());
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().profile_changes);             // 0 → 6, no intermediate
+    TEST_ASSERT_EQUAL(HWAbstraction::HW_INVALID_ARG, sim.hw_port_write_masked(0xFF, 1, 1));
+}
+
+
+// ----------------------------------------
+//               AD9910 DRIVER
+// ----------------------------------------
+
+// --- TEST : dds_init programs CFR1/2/3 + FSC in one CS assertion, one IO_UPDATE
+void test_driver_init_registers() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    TEST_ASSERT_EQUAL_HEX32(0x00000002u, sim.sim_active(ad9910_reg::Reg::CFR1));   // SDIO input only
+    TEST_ASSERT_EQUAL_HEX32(0x01000020u, sim.sim_active(ad9910_reg::Reg::CFR2));   // ASF from profile, sync val. disable
+    TEST_ASSERT_EQUAL_HEX32(0x0000007Fu, sim.sim_active(ad9910_reg::Reg::AUX_DAC));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().master_resets);
+    TEST_ASSERT_EQUAL_UINT32(4, sim.sim_stats().frames);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_UINT32(20, sim.sim_stats().last_update_bytes);                 // 4 × (header + 4)
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().protocol_errors);
+}
+
+// --- TEST : single tone on a profile, bytes and latency per update
+void test_driver_freq_out_profile() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    sim.sim_reset_stats();
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE3>(10000000u, 0)));
+
+    const uint64_t p3 = sim.sim_active(ad9910_reg::Reg::PROFILE3);
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(10000000u), static_cast<uint32_t>(p3));
+    TEST_ASSERT_EQUAL_HEX16(0x3FFFu, static_cast<uint16_t>(p3 >> 48));                // 0 dB → full scale
+    TEST_ASSERT_EQUAL_UINT8(3, sim.sim_profile());
+    TEST_ASSERT_EQUAL_UINT32(9, sim.sim_stats().spi_bytes);                           // header + 8
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+    TEST_ASSERT_GREATER_THAN(0u, sim.sim_stats().time_ns);
+}
+
+// --- TEST : identical rewrite of a profile is served from the register cache
+void test_driver_cache_skips_identical_write() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE3>(10000000u, 0)));
+    sim.sim_reset_stats();
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE3>(10000000u, 0)));
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().spi_bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().cs_assertions);
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE3>(12000000u, 0)));
+    TEST_ASSERT_EQUAL_UINT32(9, sim.sim_stats().spi_bytes);
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(12000000u),
+                            static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::PROFILE3)));
+}
+
+// --- TEST : repeated sweep only rewrites the registers that changed
+void test_driver_cache_sweep_repeat() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_sweep(1000000u, 2000000u, 10u, SweepTimeFormat::Milliseconds, false));
+    const uint64_t limit = sim.sim_active(ad9910_reg::Reg::DR_LIMIT);
+    sim.sim_reset_stats();
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_sweep(1000000u, 2000000u, 10u, SweepTimeFormat::Milliseconds, false));
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().spi_bytes);
+    TEST_ASSERT_EQUAL_HEX64(limit, sim.sim_active(ad9910_reg::Reg::DR_LIMIT));
+}
+
+// --- TEST : after an external reset the cache must be dropped before writes go out again
+void test_driver_cache_invalidate() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE0>(5000000u, 0)));
+
+    sim.hw_pin_write(ix(DdsPin::MASTER_RESET), HWAbstraction::HW_PIN_HIGH);  // behind the driver's back
+    sim.hw_pin_write(ix(DdsPin::MASTER_RESET), HWAbstraction::HW_PIN_LOW);
+    sim.sim_reset_stats();
+
+    dds.dds_reg_cache_invalidate();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE0>(5000000u, 0)));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().frames);
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(5000000u),
+                            static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::PROFILE0)));
+}
+
+// --- TEST : two devices on one controller keep their own register images
+void test_driver_two_instances() {
+    NativeSimBoard sim_a, sim_b;
+    AD9910Context ctx_b = make_ctx();
+    ctx_b.dac_high_current = true;
+    AD9910 dds_a(sim_a, kSpiCfg, make_ctx());
+    AD9910 dds_b(sim_b, kSpiCfg, ctx_b);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds_a.dds_init());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds_b.dds_init());
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds_a.dds_freq_out<ad9910_reg::PROFILE1>(1000000u, 0)));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds_b.dds_freq_out<ad9910_reg::PROFILE1>(2000000u, 0)));
+
+    TEST_ASSERT_EQUAL_HEX32(0x7Fu, dds_a.dds_regs().aux_dac.val);
+    TEST_ASSERT_EQUAL_HEX32(0xFFu, dds_b.dds_regs().aux_dac.val);
+    TEST_ASSERT_EQUAL_HEX32(dds_a.dds_freq_ftw(1000000u), static_cast<uint32_t>(dds_a.dds_regs().profile[1].val));
+    TEST_ASSERT_EQUAL_HEX32(dds_b.dds_freq_ftw(2000000u), static_cast<uint32_t>(dds_b.dds_regs().profile[1].val));
+    TEST_ASSERT_EQUAL_HEX64(sim_a.sim_active(ad9910_reg::Reg::PROFILE1), dds_a.dds_regs().profile[1].val);
+    TEST_ASSERT_EQUAL_HEX64(sim_b.sim_active(ad9910_reg::Reg::PROFILE1), dds_b.dds_regs().profile[1].val);
+}
+
+// --- TEST : a sweep programs CFR1, DR_LIMIT/STEP/RATE and CFR2 in one burst
+void test_driver_sweep_single_burst() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    sim.sim_reset_stats();
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_sweep(1000000u, 2000000u, 10u, SweepTimeFormat::Milliseconds, true));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().cs_assertions);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().spi_calls);
+    TEST_ASSERT_EQUAL_UINT32(5, sim.sim_stats().frames);                             // CFR1, DR × 3, CFR2
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().protocol_errors);
+    TEST_ASSERT_EQUAL_HEX32(0x000E0000u, sim.sim_active(ad9910_reg::Reg::CFR2));      // DRG on, no-dwell
+    TEST_ASSERT_EQUAL_HEX64(sim.sim_active(ad9910_reg::Reg::DR_STEP), dds.dds_regs().dr_step.val);
+
+    // Only CFR2 differs on the second call
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_sweep(1000000u, 2000000u, 10u, SweepTimeFormat::Milliseconds, false));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().frames);
+    TEST_ASSERT_EQUAL_UINT32(5, sim.sim_stats().spi_bytes);
+}
+
+static int64_t abs64(int64_t v) { return v < 0 ? -v : v; }
+
+// --- TEST : the sweep report matches the DRG registers and beats the single-knob rounding
+void test_driver_sweep_report() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    const uint64_t sysclk = dds.dds_sysclk_hz();
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_sweep(1000000u, 2000000u, 10u, SweepTimeFormat::Milliseconds, false));
+    const AD9910::sweep_report_t& r = dds.dds_last_sweep();
+    TEST_ASSERT_EQUAL_HEX64(ad9910_reg::DR_STEP::set_step(r.ftw_step, r.ftw_step).val,
+                            sim.sim_active(ad9910_reg::Reg::DR_STEP));
+    TEST_ASSERT_EQUAL_HEX32(ad9910_reg::DR_RATE::set_rate(r.step_rate, r.step_rate).val,
+                            static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::DR_RATE)));
+
+    // Achieved time from the chip's own view: ceil(delta / step) × rate DRG ticks
+    const uint32_t delta = dds.dds_freq_ftw(2000000u) - dds.dds_freq_ftw(1000000u);
+    const uint64_t steps = (uint64_t(delta) + r.ftw_step - 1u) / r.ftw_step;
+    TEST_ASSERT_EQUAL_UINT64(ad9910_math::drg_ns_from_ticks(steps * r.step_rate, sysclk), r.achieved_ns);
+    TEST_ASSERT_EQUAL_INT(int64_t(r.achieved_ns) - 10000000, r.duration_error_ns);
+
+    uint32_t fs; uint16_t sr;                                       // old: one knob rounded
+    TEST_ASSERT_TRUE(ad9910_math::drg_step_rate(delta, 10000000u, sysclk, fs, sr));
+    const int64_t old_ns = int64_t(ad9910_math::drg_ns_from_ticks(((uint64_t(delta) + fs - 1u) / fs) * sr, sysclk));
+    TEST_ASSERT_TRUE(abs64(r.duration_error_ns) * 10 < abs64(old_ns - 10000000));
+    TEST_ASSERT_TRUE(abs64(r.duration_error_ns) < 10000);     // < 0.1 %
+
+    // End frequency only carries the FTW quantisation (≤ half an LSB)
+    const int64_t half_lsb_mhz = int64_t((sysclk * 1000u) >> 33) + 1;
+    TEST_ASSERT_TRUE(abs64(r.end_freq_error_mhz) <= half_lsb_mhz);
+}
+
+// --- TEST : asymmetric triangle and sawtooth put independent slopes in each register half
+void test_driver_freq_ramp_asymmetric() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    const uint32_t lo = dds.dds_freq_ftw(1000000u), hi = dds.dds_freq_ftw(2000000u);
+
+    // 1 ms up, 250 us down, no dwell at either end: runs on its own
+    AD9910::freq_ramp_t tri = { 1000000u, 2000000u, 1000000u, 250000u, true, true, true };
+    AD9910::freq_ramp_t got;
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_ramp(tri, &got));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().cs_assertions);
+    TEST_ASSERT_EQUAL_HEX32(0x000E0000u, sim.sim_active(ad9910_reg::Reg::CFR2));
+    TEST_ASSERT_EQUAL_HEX64(ad9910_reg::DR_LIMIT::set_limit(lo, hi).val, sim.sim_active(ad9910_reg::Reg::DR_LIMIT));
+    TEST_ASSERT_TRUE(sim.sim_pin_level(pin(DdsPin::DRCTL)));
+
+    const uint64_t step = sim.sim_active(ad9910_reg::Reg::DR_STEP);
+    const uint64_t rate = sim.sim_active(ad9910_reg::Reg::DR_RATE);
+    const uint32_t inc = uint32_t(step), dec = uint32_t(step >> 32);
+    const uint16_t pos = uint16_t(rate), neg = uint16_t(rate >> 16);
+    TEST_ASSERT_TRUE(inc != dec || pos != neg);
+    const uint64_t sysclk = dds.dds_sysclk_hz();
+    TEST_ASSERT_EQUAL_UINT64(ad9910_math::drg_ns_from_ticks(uint64_t((hi - lo + inc - 1u) / inc) * pos, sysclk), got.rise_ns);
+    TEST_ASSERT_EQUAL_UINT64(ad9910_math::drg_ns_from_ticks(uint64_t((hi - lo + dec - 1u) / dec) * neg, sysclk), got.fall_ns);
+    TEST_ASSERT_UINT64_WITHIN(1000u, 1000000u, got.rise_ns);            // 0.1 %
+    TEST_ASSERT_UINT64_WITHIN(250u,   250000u, got.fall_ns);
+
+    // Sawtooth down: instant rise, 500 us fall, starting on the falling slope
+    AD9910::freq_ramp_t saw = { 1000000u, 2000000u, 0u, 500000u, true, true, false };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_ramp(saw, &got));
+    TEST_ASSERT_EQUAL_HEX32(hi - lo, static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::DR_STEP)));
+    TEST_ASSERT_EQUAL_UINT16(1, static_cast<uint16_t>(sim.sim_active(ad9910_reg::Reg::DR_RATE)));
+    TEST_ASSERT_FALSE(sim.sim_pin_level(pin(DdsPin::DRCTL)));
+
+    // One-shot with dwell high only cleared
+    AD9910::freq_ramp_t one = { 1000000u, 2000000u, 1000000u, 1000000u, true, false, true };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_ramp(one));
+    TEST_ASSERT_EQUAL_HEX32(0x000C0000u, sim.sim_active(ad9910_reg::Reg::CFR2));
+
+    AD9910::freq_ramp_t bad = { 2000000u, 1000000u, 1u, 1u, true, true, true };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, dds.dds_freq_ramp(bad));
+}
+
+// --- TEST : phase and amplitude ramps land in the accumulator MSBs with the carrier in PROFILE0
+void test_driver_drg_phase_ampl() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    TEST_ASSERT_EQUAL_HEX16(0x4000u, ad9910_math::pow_from_cdeg(9000u));
+    TEST_ASSERT_EQUAL_HEX16(0x8000u, ad9910_math::pow_from_cdeg(18000u));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFFu, ad9910_math::pow_from_cdeg(36000u));
+
+    // 0° → 180° and back, 100 us each way, free running
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_phase_ramp(10000000u, 0u, 18000u, 100000u, 100000u, true));
+    TEST_ASSERT_EQUAL_HEX32(0x001E0000u, sim.sim_active(ad9910_reg::Reg::CFR2));          // DR_DEST = phase
+    TEST_ASSERT_EQUAL_HEX64(ad9910_reg::DR_LIMIT::set_limit(0u, 0x80000000u).val, sim.sim_active(ad9910_reg::Reg::DR_LIMIT));
+    TEST_ASSERT_EQUAL_HEX64(ad9910_reg::PROFILE0::single_tone(dds.dds_freq_ftw(10000000u), 0, 0x3FFFu).val,
+                            sim.sim_active(ad9910_reg::Reg::PROFILE0));
+
+    // -20 dB → 0 dB once: limits are the ASFs shifted into [31:18]
+    AD9910::drg_ramp_t got;
+    const AD9910::drg_ramp_t am = { AD9910::DrgDest::Amplitude, ad9910_math::asf_from_cdb(-2000), 0x3FFFu,
+                                    1000000u, 1000000u, false, false, true };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_drg_ramp(am, dds.dds_freq_ftw(10000000u), &got));
+    TEST_ASSERT_EQUAL_HEX32(0x00280000u, sim.sim_active(ad9910_reg::Reg::CFR2));          // DR_DEST = amplitude
+    TEST_ASSERT_EQUAL_HEX64(ad9910_reg::DR_LIMIT::set_limit(uint32_t(am.lower) << 18, 0x3FFFu << 18).val,
+                            sim.sim_active(ad9910_reg::Reg::DR_LIMIT));
+    TEST_ASSERT_UINT64_WITHIN(1000u, 1000000u, got.rise_ns);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_ampl_ramp(10000000u, -2000, 0, 1000000u, 1000000u, false));
+    TEST_ASSERT_EQUAL_HEX64(ad9910_reg::DR_LIMIT::set_limit(uint32_t(am.lower) << 18, 0x3FFFu << 18).val,
+                            sim.sim_active(ad9910_reg::Reg::DR_LIMIT));
+
+    // Out of the destination's word width / reversed
+    AD9910::drg_ramp_t bad = am;
+    bad.upper = 0x4000u;
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, dds.dds_drg_ramp(bad));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, dds.dds_phase_ramp(10000000u, 9000u, 4500u, 1u, 1u, true));
+}
+
+// --- TEST : IO_UPDATE pulse width from the context, internal timer takes the pin over
+void test_driver_io_update_modes() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    // Default: high for 10 us, then low (cached profile write: the pulse alone)
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_profile_load(2, 1000u, 0, 0x3FFFu));
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_profile_load(2, 1000u, 0, 0x3FFFu));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_UINT32(2, sim.sim_stats().pin_writes);
+    const uint64_t t_default = sim.sim_time_ns();
+
+    // 0: the two pin writes alone, 3: three microseconds more
+    uint64_t t_pulse = 0;
+    for (uint16_t us : { uint16_t(0), uint16_t(3) }) {
+        NativeSimBoard sim_w;
+        AD9910Context ctx = make_ctx();
+        ctx.io_update_pulse_us = us;
+        AD9910 dds_w(sim_w, kSpiCfg, ctx);
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds_w.dds_init());
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds_w.dds_profile_load(2, 1000u, 0, 0x3FFFu));
+        sim_w.sim_reset_stats();
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds_w.dds_profile_load(2, 1000u, 0, 0x3FFFu));
+        if (us == 0) t_pulse = sim_w.sim_time_ns();
+        TEST_ASSERT_EQUAL_UINT64(t_pulse + us * 1000u, sim_w.sim_time_ns());
+    }
+    TEST_ASSERT_EQUAL_UINT64(t_pulse + 10000u, t_default);
+
+    // Internal, 1 ms: one last pulse latches CFR2, then the pin is the chip's
+    uint64_t period = 0;
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_io_update_internal(1000000u, &period));
+    TEST_ASSERT_TRUE(dds.dds_io_update_is_internal());
+    TEST_ASSERT_EQUAL_UINT64(1000000u, period);
+    TEST_ASSERT_EQUAL_HEX32(0x00800000u, static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::CFR2)) & 0x0080C000u);
+    TEST_ASSERT_EQUAL_HEX32(ad9910_math::drg_ticks_from_ns(1000000u, dds.dds_sysclk_hz()),
+                            static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::IO_UPDATE_RATE)));
+    TEST_ASSERT_FALSE(sim.sim_pin_output(pin(DdsPin::IO_UPDATE)));
+
+    // Writes are only staged, CFR2 images built elsewhere keep the mode
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE1>(3000000u, 0)));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_sweep(1000000u, 2000000u, 10u, SweepTimeFormat::Milliseconds, true));
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(3000000u), static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::PROFILE1)));
+    TEST_ASSERT_EQUAL_HEX32(0x008E0000u, static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::CFR2)));
+
+    // Longer than 0xFFFFFFFF ticks: prescaler kicks in
+    uint8_t a; uint32_t rb;
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_io_update_internal(60000000000ull, &period));
+    TEST_ASSERT_TRUE(ad9910_math::io_update_fit(ad9910_math::drg_ticks_from_ns(60000000000ull, dds.dds_sysclk_hz()), a, rb) != 0);
+    TEST_ASSERT_TRUE(a > 0);
+    TEST_ASSERT_EQUAL_HEX32(0x00800000u | (uint32_t(a) << 14), static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::CFR2)) & 0x0080C000u);
+    TEST_ASSERT_EQUAL_HEX32(rb, static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::IO_UPDATE_RATE)));
+    TEST_ASSERT_UINT64_WITHIN(100u, 60000000000ull, period);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_io_update_internal(1000000u));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, dds.dds_io_update_internal(10u));
+
+    // Back to external after one period
+    const uint64_t t0 = sim.sim_time_ns();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_io_update_external());
+    TEST_ASSERT_GREATER_OR_EQUAL(1000000u, sim.sim_time_ns() - t0);
+    TEST_ASSERT_TRUE(sim.sim_pin_output(pin(DdsPin::IO_UPDATE)));
+    TEST_ASSERT_EQUAL_HEX32(0u, static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::CFR2)) & 0x0080C000u);
+}
+
+// --- TEST : batch bookkeeping, in-place filtering and overflow
+void test_reg_batch_drop_and_overflow() {
+    RegisterBatch b;
+    TEST_ASSERT_TRUE(b.add(ad9910_reg::fixed::CFR1_DEFAULTS));
+    TEST_ASSERT_TRUE(b.add<ad9910_reg::POW>(ad9910_reg::POW::value_type(0x1234u)));
+    TEST_ASSERT_TRUE(b.add(ad9910_reg::fixed::AUX_DAC_FSC_HIGH));
+    TEST_ASSERT_EQUAL_UINT8(3, b.count());
+    TEST_ASSERT_EQUAL_UINT8(5 + 3 + 5, b.size());
+
+    b.drop_if([](uint8_t addr, const uint8_t*, uint8_t) { return addr == 0x00; });
+    const uint8_t exp[] = { 0x08, 0x12, 0x34,  0x03, 0x00, 0x00, 0x00, 0xFF };
+    TEST_ASSERT_EQUAL_UINT8(2, b.count());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(exp, b.data(), sizeof(exp));
+    TEST_ASSERT_EQUAL_UINT8(0x03, b.entry(1).addr);
+
+    const uint8_t two[2] = { 0, 0 };
+    TEST_ASSERT_FALSE(b.add(0x07, two, 2));                 // FTW is 4 bytes
+    TEST_ASSERT_TRUE(b.overflow());
+    b.clear();
+    TEST_ASSERT_TRUE(b.empty());
+    TEST_ASSERT_FALSE(b.overflow());
+}
+
+// --- TEST : profile select uses one masked write per port (Mega map: PJ0 + PH1/PH0 → 2)
+void test_driver_profile_select_ports() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE7>(1000000u, 0)));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE0>(1000000u, 0)));
+    sim.sim_reset_stats();
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, (dds.dds_freq_out<ad9910_reg::PROFILE7>(1000000u, 0)));  // cached: pins only
+    TEST_ASSERT_EQUAL_UINT8(7, sim.sim_profile());
+    TEST_ASSERT_EQUAL_UINT32(2, sim.sim_stats().port_writes);
+    TEST_ASSERT_EQUAL_UINT32(2, sim.sim_stats().pin_writes);                          // 1 IO_UPDATE pulse, no PROFILE pin_write
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, sim.sim_stats().profile_changes);
+}
+
+// --- TEST : profile sequencer plays a 20-entry list through 8 slots, triggers are pin-only
+void test_profile_sequencer_playback() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    uint32_t freqs[20];
+    for (size_t i = 0; i < 20; i++) freqs[i] = 1000000u + 250000u * i;
+    ProfileSequencer::entry_t list[20];
+    ProfileSequencer::prepare(dds, freqs, 20, 0, list);
+
+    ProfileSequencer seq(dds);
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.start(list, 20));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_UINT32(8, seq.loaded());
+    TEST_ASSERT_EQUAL_UINT8(0, sim.sim_profile());
+
+    for (size_t i = 1; i < 20; i++) {
+        while (seq.service()) {}
+        sim.sim_reset_stats();
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.trigger());
+        TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().spi_bytes);
+        TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().io_updates);
+
+        const uint8_t slot = static_cast<uint8_t>(i % 8);
+        const auto reg = static_cast<ad9910_reg::Reg>(ad9910_reg::PROFILE0::address + slot);
+        TEST_ASSERT_EQUAL_UINT8(slot, sim.sim_profile());
+        TEST_ASSERT_EQUAL_HEX32(list[i].ftw, static_cast<uint32_t>(sim.sim_active(reg)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, seq.underruns());
+    TEST_ASSERT_FALSE(seq.done());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.trigger());
+    TEST_ASSERT_TRUE(seq.done());
+    TEST_ASSERT_EQUAL_UINT32(19, seq.position());
+}
+
+// --- TEST : without service() the ninth trigger underruns and the output holds
+void test_profile_sequencer_underrun() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    uint32_t freqs[12];
+    for (size_t i = 0; i < 12; i++) freqs[i] = 2000000u + 1000u * i;
+    ProfileSequencer::entry_t list[12];
+    ProfileSequencer::prepare(dds, freqs, 12, 0, list);
+
+    ProfileSequencer seq(dds);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.start(list, 12));
+    for (size_t i = 1; i < 8; i++) TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.trigger());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_TIMEOUT, seq.trigger());
+    TEST_ASSERT_EQUAL_UINT32(1, seq.underruns());
+    TEST_ASSERT_EQUAL_UINT32(7, seq.position());
+    TEST_ASSERT_EQUAL_UINT8(7, sim.sim_profile());
+
+    TEST_ASSERT_TRUE(seq.service());        // entry 8 → slot 0, slots 1..3 still due
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.trigger());
+    TEST_ASSERT_EQUAL_UINT8(0, sim.sim_profile());
+    TEST_ASSERT_EQUAL_HEX32(list[8].ftw, static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::PROFILE0)));
+}
+
+// --- TEST : 5000-entry shot streamed through a 64-frame ring, producer interleaved with triggers
+void test_profile_sequencer_stream() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    constexpr size_t N = 5000;
+    auto ftw_of = [](size_t i) { return 0x01000000u + static_cast<uint32_t>(i) * 977u; };
+
+    static ProfileSequencer::stream_t ring;
+    ring.reset();
+    ProfileSequencer seq(dds);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_TIMEOUT, seq.start(ring, N));      // nothing received yet
+
+    size_t produced = 0;
+    while (produced < 16) ring.push(ProfileSequencer::frame(ftw_of(produced++), 0, 0x3FFFu));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.start(ring, N));
+    TEST_ASSERT_EQUAL_UINT32(8, seq.loaded());
+    TEST_ASSERT_EQUAL_UINT8(8, ring.size());
+
+    for (size_t i = 1; i < N; i++) {
+        for (int k = 0; k < 2 && produced < N && !ring.full(); k++)        // "RX interrupt", host paced by ACKs
+            if (ring.push(ProfileSequencer::frame(ftw_of(produced), 0, 0x3FFFu))) produced++;
+        while (seq.service()) {}
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.trigger());
+
+        const auto reg = static_cast<ad9910_reg::Reg>(ad9910_reg::PROFILE0::address + i % 8);
+        TEST_ASSERT_EQUAL_HEX32(ftw_of(i), static_cast<uint32_t>(sim.sim_active(reg)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(N - 1, seq.position());
+    TEST_ASSERT_EQUAL_UINT32(0, seq.underruns());
+    TEST_ASSERT_EQUAL_UINT32(0, ring.overruns());
+    TEST_ASSERT_TRUE(ring.empty());
+
+    // Full ring drops and counts; spans stop at the wrap point
+    SpscRing<uint32_t, 8> r;
+    for (uint32_t v = 0; v < 8; v++) TEST_ASSERT_TRUE(r.push(v));
+    TEST_ASSERT_FALSE(r.push(99));
+    TEST_ASSERT_EQUAL_UINT32(1, r.overruns());
+    uint32_t out = 0;
+    for (uint32_t v = 0; v < 6; v++) { TEST_ASSERT_TRUE(r.pop(out)); TEST_ASSERT_EQUAL_UINT32(v, out); }
+    uint8_t n = 0;
+    uint32_t* w = r.write_span(&n);
+    TEST_ASSERT_EQUAL_UINT8(6, n);                                          // slots 0..5 free, none past the end
+    w[0] = 8; w[1] = 9;
+    r.commit(2);
+    const uint32_t* rd = r.read_span(&n);
+    TEST_ASSERT_EQUAL_UINT8(2, n);                                          // 6, 7 up to the wrap
+    TEST_ASSERT_EQUAL_UINT32(6, rd[0]);
+    r.release(2);
+    TEST_ASSERT_TRUE(r.pop(out));
+    TEST_ASSERT_EQUAL_UINT32(8, out);
+}
+
+// --- TEST : up / down / flat breakpoints compile to DRG frames, absolute times within one tick
+void test_sweep_plan_compile() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    const SweepPlan::point_t pts[] = {
+        { 10000000u,       0ull },
+        { 20000000u, 1000000ull },      // up 10 MHz in 1 ms
+        {  5000000u, 1500333ull },      // down
+        {  5000000u, 2000000ull },      // hold
+        { 12000000u, 2200007ull },      // up
+    };
+    SweepPlan::segment_t seg[4];
+    uint64_t worst = 0;
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, SweepPlan::compile(dds, pts, 5, seg, &worst));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT64(200, worst);                       // 0.0002 of the shortest segment
+
+    TEST_ASSERT_EQUAL(SweepPlan::Dir::UP,   seg[0].dir);
+    TEST_ASSERT_EQUAL(SweepPlan::Dir::DOWN, seg[1].dir);
+    TEST_ASSERT_EQUAL(SweepPlan::Dir::HOLD, seg[2].dir);
+    TEST_ASSERT_EQUAL(SweepPlan::Dir::UP,   seg[3].dir);
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(20000000u), seg[1].ftw_start);
+
+    // Down segment: lower = end, upper = start
+    const auto lim = ad9910_reg::DR_LIMIT::frame(ad9910_reg::DR_LIMIT::set_limit(dds.dds_freq_ftw(5000000u),
+                                                                               dds.dds_freq_ftw(20000000u)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(lim.data(), seg[1].frames, lim.size());
+
+    uint64_t total = 0;
+    for (const auto& g : seg) total += g.duration_ns;
+    TEST_ASSERT_UINT64_WITHIN(worst, 2200007ull, total);
+
+    const SweepPlan::point_t bad[] = { { 1000000u, 10ull }, { 2000000u, 10ull } };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, SweepPlan::compile(dds, bad, 2, seg));
+}
+
+// --- TEST : DROVER re-arms each segment with one burst, DRCTL follows the direction
+void test_sweep_plan_drover_rearm() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    const SweepPlan::point_t pts[] = {
+        { 10000000u,      0ull },
+        { 30000000u, 200000ull },
+        {  1000000u, 500000ull },
+        {  2000000u, 600000ull },
+    };
+    SweepPlan::segment_t seg[3];
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, SweepPlan::compile(dds, pts, 4, seg));
+
+    SweepPlan plan(dds);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, plan.start(seg, 3));
+    TEST_ASSERT_EQUAL_HEX64(ad9910_reg::DR_LIMIT::set_limit(dds.dds_freq_ftw(10000000u), dds.dds_freq_ftw(30000000u)).val,
+                            sim.sim_active(ad9910_reg::Reg::DR_LIMIT));
+    TEST_ASSERT_TRUE(sim.sim_pin_level(pin(DdsPin::DRCTL)));
+    TEST_ASSERT_EQUAL_UINT64(0, sim.sim_active(ad9910_reg::Reg::CFR1) & (1u << 14));   // no autoclear
+
+    const pin_t drover = pin(DdsPin::DROVER);
+    sim.sim_set_pin_level(drover, true);                // still the priming limit: ignored
+    TEST_ASSERT_TRUE(plan.service());
+    TEST_ASSERT_EQUAL_UINT32(0, plan.segment());
+
+    sim.sim_set_pin_level(drover, false);
+    TEST_ASSERT_TRUE(plan.service());
+    sim.sim_set_pin_level(drover, true);                // segment 0 reached 30 MHz
+    sim.sim_reset_stats();
+    TEST_ASSERT_TRUE(plan.service());
+    TEST_ASSERT_EQUAL_UINT32(1, plan.segment());
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().cs_assertions);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(SweepPlan::FRAME_BYTES, sim.sim_stats().spi_bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+    TEST_ASSERT_FALSE(sim.sim_pin_level(pin(DdsPin::DRCTL)));             // down
+    TEST_ASSERT_EQUAL_HEX64(ad9910_reg::DR_LIMIT::set_limit(dds.dds_freq_ftw(1000000u), dds.dds_freq_ftw(30000000u)).val,
+                            sim.sim_active(ad9910_reg::Reg::DR_LIMIT));
+
+    sim.sim_set_pin_level(drover, false); plan.service();
+    sim.sim_set_pin_level(drover, true);  plan.service();
+    TEST_ASSERT_EQUAL_UINT32(2, plan.segment());
+    TEST_ASSERT_TRUE(sim.sim_pin_level(pin(DdsPin::DRCTL)));
+    sim.sim_set_pin_level(drover, false); plan.service();
+    sim.sim_set_pin_level(drover, true);
+    TEST_ASSERT_FALSE(plan.service());
+    TEST_ASSERT_TRUE(plan.done());
+
+    // A flat segment needs the timer
+    const SweepPlan::point_t hold[] = { { 1000000u, 0ull }, { 1000000u, 1000ull } };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, SweepPlan::compile(dds, hold, 2, seg));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, plan.start(seg, 1));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, plan.start(seg, 1, SweepPlan::Rearm::TIMER));
+    TEST_ASSERT_EQUAL_UINT64(1000, plan.current_ns());
+}
+
+// --- TEST : a segment that ends between two service() polls can't be played on DROVER
+void test_sweep_plan_drover_short_segment() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    const SweepPlan::point_t pts[] = {
+        { 10000000u,      0ull },
+        { 20000000u, 200000ull },
+        { 21000000u, 210000ull },                       // 10 us: over before the next poll
+    };
+    SweepPlan::segment_t seg[2];
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, SweepPlan::compile(dds, pts, 3, seg));
+    TEST_ASSERT_TRUE(seg[1].duration_ns < SweepPlan::DROVER_MIN_NS);
+
+    SweepPlan plan(dds);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, plan.start(seg, 2));
+
+    // The timer doesn't depend on seeing DROVER low: the pin bouncing unseen changes nothing
+    const pin_t drover = pin(DdsPin::DROVER);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, plan.start(seg, 2, SweepPlan::Rearm::TIMER));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, plan.next());
+    sim.sim_set_pin_level(drover, false);
+    sim.sim_set_pin_level(drover, true);                // segment 1 over between two polls
+    TEST_ASSERT_FALSE(plan.service());                  // DROVER polling is not in charge
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, plan.next());
+    TEST_ASSERT_TRUE(plan.done());
+
+    // Every segment long enough: DROVER is accepted
+    const SweepPlan::point_t slow[] = { { 10000000u, 0ull }, { 20000000u, 2 * SweepPlan::DROVER_MIN_NS } };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, SweepPlan::compile(dds, slow, 2, seg));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, plan.start(seg, 1));
+}
+
+// --- TEST : RAM waveform goes out in one CS assertion and lands at the profile's range
+void test_driver_ram_load_and_play() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    uint32_t words[256];
+    for (uint16_t i = 0; i < 256; i++)
+        words[i] = ad9910_reg::ram_word::polar(uint16_t(i * 256u), uint16_t(0x3FFFu - i));
+
+    const AD9910::ram_profile_t p = { 100, 355, dds.dds_ram_step_rate(1000),
+                                      AD9910::RamMode::ContinuousRecirculate, false, false };
+    TEST_ASSERT_EQUAL_UINT16(4 * p.step_rate, dds.dds_ram_step_rate(4000));
+    TEST_ASSERT_EQUAL_UINT16(1, dds.dds_ram_step_rate(0));                           // clamped
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_ram_load(1, p, words));
+    TEST_ASSERT_EQUAL_UINT32(2, sim.sim_stats().cs_assertions);                      // RAM profile, RAM
+    TEST_ASSERT_EQUAL_UINT32(9 + 1 + 256 * 4, sim.sim_stats().spi_bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().protocol_errors);
+    for (uint16_t i = 0; i < 256; i++) TEST_ASSERT_EQUAL_HEX32(words[i], sim.sim_ram(100 + i));
+    TEST_ASSERT_EQUAL_HEX32(0, sim.sim_ram(99));
+    TEST_ASSERT_EQUAL_HEX32(0, sim.sim_ram(356));
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_ram_play(1, AD9910::RamDest::Polar, dds.dds_freq_ftw(10000000u)));
+    TEST_ASSERT_EQUAL_UINT8(1, sim.sim_profile());
+    TEST_ASSERT_EQUAL_HEX32(0xE0000002u, sim.sim_active(ad9910_reg::Reg::CFR1));     // RAM on, polar
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(10000000u), sim.sim_active(ad9910_reg::Reg::FTW));
+    const auto prof = ad9910_reg::RAM_PROFILE::value_type(sim.sim_active(ad9910_reg::Reg::PROFILE1));
+    TEST_ASSERT_EQUAL_UINT16(100, ad9910_reg::RAM_PROFILE::start_of(prof));
+    TEST_ASSERT_EQUAL_UINT16(355, ad9910_reg::RAM_PROFILE::end_of(prof));
+    TEST_ASSERT_EQUAL_HEX8(4, ad9910_reg::RAM_PROFILE::extract<ad9910_reg::RAM_PROFILE::MODE>(prof));
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_ram_stop());
+    TEST_ASSERT_EQUAL_HEX32(0x00000002u, sim.sim_active(ad9910_reg::Reg::CFR1));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM,
+                      dds.dds_ram_load(1, { 10, 1024, 1, AD9910::RamMode::RampUp, false, false }, words));
+}
+
+
+// --- TEST : raw register writes (profile bytes, RAM profiles) keep the register bank in step
+void test_driver_raw_write_tracks_bank() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    const auto raw = pack_be<8>(ad9910_reg::PROFILE0::single_tone(dds.dds_freq_ftw(7000000u), 0x1234u, 0x2000u).val);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_profile_load_raw(2, raw.data(), false));
+    TEST_ASSERT_EQUAL_HEX64(sim.sim_staged(ad9910_reg::Reg::PROFILE2), dds.dds_regs().profile[2].val);
+
+    const AD9910::ram_profile_t p = { 0, 63, 10, AD9910::RamMode::RampUp, false, false };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_ram_profile(3, p));
+    TEST_ASSERT_EQUAL_HEX64(sim.sim_staged(ad9910_reg::Reg::PROFILE3), dds.dds_regs().profile[3].val);
+}
+
+// --- TEST : auto OSK programs ASF rate / scale / step, then the pin alone keys the output
+void test_driver_osk_auto_and_manual() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    const uint32_t cfr1 = static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::CFR1));
+
+    // Full scale in 1 ms, best step size
+    uint64_t rise = 0;
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_osk_auto(0, 1000000u, 0, &rise));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().cs_assertions);
+    TEST_ASSERT_EQUAL_HEX32(cfr1 | 0x00000300u, static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::CFR1)));
+    TEST_ASSERT_FALSE(sim.sim_pin_level(pin(DdsPin::OSK)));
+
+    const uint32_t asf  = static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::ASF));
+    const uint16_t rate = uint16_t(asf >> 16);
+    const uint8_t  code = uint8_t(asf & 0x3u);
+    TEST_ASSERT_EQUAL_HEX16(0x3FFFu, uint16_t((asf >> 2) & 0x3FFFu));
+    const uint64_t steps = (0x3FFFu + (1u << code) - 1u) >> code;
+    TEST_ASSERT_EQUAL_UINT64(ad9910_math::drg_ns_from_ticks(steps * rate, dds.dds_sysclk_hz()), rise);
+    TEST_ASSERT_UINT64_WITHIN(1000u, 1000000u, rise);                                     // 0.1 %
+
+    // Keying is a pin edge, no SPI
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_osk_key(true));
+    TEST_ASSERT_TRUE(sim.sim_pin_level(pin(DdsPin::OSK)));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_osk_key(false));
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().spi_bytes);
+
+    // Forced step size: 8 LSBs
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_osk_auto(-600, 1000000u, 8));
+    TEST_ASSERT_EQUAL_HEX8(3, uint8_t(sim.sim_active(ad9910_reg::Reg::ASF) & 0x3u));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, dds.dds_osk_auto(0, 1000u, 3));
+
+    // Manual: on / off switching, no ramp
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_osk_manual(-600));
+    TEST_ASSERT_EQUAL_HEX32(cfr1 | 0x00800200u, static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::CFR1)));
+    TEST_ASSERT_EQUAL_HEX16(ad9910_math::asf_from_cdb(-600),
+                            uint16_t((sim.sim_active(ad9910_reg::Reg::ASF) >> 2) & 0x3FFFu));
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_osk_off());
+    TEST_ASSERT_EQUAL_HEX32(cfr1, static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::CFR1)));
+}
+
+// --- TEST : parallel port streams FM / polar words at the bus rate, TxEnable frames them
+void test_driver_parallel_stream() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    // FM: 10 MHz carrier + 0..1 MHz, gain chosen for the span
+    const uint32_t base = dds.dds_freq_ftw(10000000u);
+    const uint32_t span = dds.dds_freq_ftw(11000000u) - base;
+    const uint8_t  gain = ad9910_math::par_fm_gain(span);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(0xFFFFu, span >> gain);
+    TEST_ASSERT_GREATER_THAN_UINT32(0xFFFFu, span >> (gain - 1));
+    uint16_t fm[4];
+    for (uint8_t i = 0; i < 4; ++i) fm[i] = ad9910_reg::par_word::ftw(span / 3u * i, gain);
+
+    AD9910::parallel_cfg_t cfg = { AD9910::ParDest::Frequency, base, 0, gain, false };
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_parallel_begin(cfg));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+    const uint32_t cfr2 = static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::CFR2));
+    TEST_ASSERT_EQUAL_HEX32(0x00000810u | gain, cfr2 & 0x00080E5Fu);              // port + PDCLK, DRG off
+    TEST_ASSERT_FALSE(sim.sim_pin_level(pin(DdsPin::TX_ENABLE)));
+    TEST_ASSERT_EQUAL_HEX32(base, sim.sim_core().ftw);
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, dds.dds_parallel_stream(fm, 4, 4));   // < 1 PDCLK (8 ns)
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_parallel_stream(fm, 4, 10000u));
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().spi_bytes);
+    TEST_ASSERT_TRUE(sim.sim_pin_level(pin(DdsPin::TX_ENABLE)));
+    for (uint8_t i = 0; i < 4; ++i) {
+        TEST_ASSERT_EQUAL_UINT32(i + 1u, dds.dds_parallel_position());
+        TEST_ASSERT_EQUAL_HEX32(base + (uint32_t(fm[i]) << gain), sim.sim_core().ftw);
+        sim.hw_delay_us(10);
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, dds.dds_parallel_position());                   // one-shot: bus keeps the last word
+    TEST_ASSERT_UINT32_WITHIN(1u << gain, dds.dds_freq_ftw(11000000u), sim.sim_core().ftw);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_parallel_stop());
+    TEST_ASSERT_EQUAL_HEX32(base, sim.sim_core().ftw);                            // no hold: port adds 0
+
+    // Polar, circular, hold last value
+    const uint16_t polar[2] = { ad9910_reg::par_word::polar(0x4000u, 0x3FFFu),
+                                ad9910_reg::par_word::polar(0xC000u, 0x2000u) };
+    cfg = { AD9910::ParDest::Polar, dds.dds_freq_ftw(5000000u), 0, 0, true };
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_parallel_begin(cfg));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_parallel_stream(polar, 2, 5000u, true));
+    sim.hw_delay_us(10);                                                          // words 0, 1, 0
+    TEST_ASSERT_EQUAL_UINT32(3, dds.dds_parallel_position());
+    TEST_ASSERT_EQUAL_HEX16(0x4000u, sim.sim_core().pow);
+    TEST_ASSERT_EQUAL_HEX16(0x3FC0u, sim.sim_core().asf);                         // ASF[13:6]
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(5000000u), sim.sim_core().ftw);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_parallel_stop());
+    TEST_ASSERT_EQUAL_HEX16(0x4000u, sim.sim_core().pow);                         // held
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_parallel_end());
+    TEST_ASSERT_EQUAL_HEX32(0u, static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::CFR2)) & 0x0810u);
+}
+
+// Bus error on the n-th hw_spi_write from now (1-based), everything else as NativeSimBoard
+class FlakySpiBoard : public NativeSimBoard {
+public:
+    void fail_in(uint32_t n) { fail_at_ = calls_ + n; }
+    hw_status_t hw_spi_write(const uint8_t* data, uint16_t len) override {
+        if (++calls_ == fail_at_) return HW_ERROR;
+        return NativeSimBoard::hw_spi_write(data, len);
+    }
+private:
+    uint32_t calls_   = 0;
+    uint32_t fail_at_ = 0;
+};
+
+// 8 profiles + DR_LIMIT / STEP / RATE + CFR1: 12 frames, 100 bytes (one batch holds 96)
+static void stage_everything(AD9910::Transaction& t, const AD9910& dds, uint32_t base_hz) {
+    for (uint8_t i = 0; i < 8; ++i) {
+        const auto v = ad9910_reg::PROFILE0::single_tone(dds.dds_freq_ftw(base_hz + i * 1000000u), 0, 0x3FFFu);
+        const auto bytes = pack_be<8>(v.val);
+        t.write_raw(uint8_t(ad9910_reg::PROFILE0::address + i), bytes.data(), 8);
+    }
+    t.write<ad9910_reg::DR_LIMIT>(ad9910_reg::DR_LIMIT::set_limit(0x10000000u, 0x20000000u))
+     .write<ad9910_reg::DR_STEP >(ad9910_reg::DR_STEP::set_step(0x100u, 0x100u))
+     .write<ad9910_reg::DR_RATE >(ad9910_reg::DR_RATE::set_rate(4u, 4u))
+     .write<ad9910_reg::CFR1    >(ad9910_reg::CFR1::osk_enable(false, dds.dds_regs().cfr1));
+}
+
+// --- TEST : a transaction larger than one batch goes out in two bursts and one IO_UPDATE
+void test_driver_transaction_single_update() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    const uint64_t p0 = sim.sim_active(ad9910_reg::Reg::PROFILE0);
+    sim.sim_reset_stats();
+
+    AD9910::Transaction t(dds);
+    stage_everything(t, dds, 1000000u);
+    t.select(5);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().cs_assertions);                       // batch full: spilled
+    TEST_ASSERT_EQUAL_HEX64(p0, sim.sim_active(ad9910_reg::Reg::PROFILE0));           // staged only
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().io_updates);
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, t.commit());
+    TEST_ASSERT_EQUAL_UINT32(2, sim.sim_stats().cs_assertions);
+    TEST_ASSERT_EQUAL_UINT32(12, sim.sim_stats().frames);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_UINT8(5, sim.sim_profile());
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(8000000u),
+                            static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::PROFILE7)));
+    TEST_ASSERT_EQUAL_HEX64(0x2000000010000000ull, sim.sim_active(ad9910_reg::Reg::DR_LIMIT));
+    TEST_ASSERT_EQUAL_HEX32(static_cast<uint32_t>(dds.dds_regs().cfr1.val),
+                            static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::CFR1)));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, t.commit());                              // closed: no-op
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().io_updates);
+}
+
+// --- TEST : a bus error after the first burst restores bank, cache and the chip's staging
+void test_driver_transaction_rollback() {
+    FlakySpiBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_profile_load(0, dds.dds_freq_ftw(3000000u), 0, 0x3FFFu));
+    const ad9910_reg::RegisterBank before = dds.dds_regs();
+    const uint64_t p0 = sim.sim_active(ad9910_reg::Reg::PROFILE0);
+    sim.fail_in(2);                                                     // the commit burst
+    sim.sim_reset_stats();
+
+    {
+        AD9910::Transaction t(dds);
+        stage_everything(t, dds, 1000000u);
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_HW_ERROR, t.commit());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_HEX64(before.profile[0].val, dds.dds_regs().profile[0].val);
+    TEST_ASSERT_EQUAL_HEX64(before.dr_limit.val,   dds.dds_regs().dr_limit.val);
+    TEST_ASSERT_EQUAL_HEX32(static_cast<uint32_t>(before.cfr1.val), static_cast<uint32_t>(dds.dds_regs().cfr1.val));
+    TEST_ASSERT_EQUAL_HEX64(p0, sim.sim_staged(ad9910_reg::Reg::PROFILE0));          // old contents back
+    TEST_ASSERT_EQUAL_HEX64(before.dr_limit.val, sim.sim_staged(ad9910_reg::Reg::DR_LIMIT));
+
+    // The aborted value is not in the cache: writing it again goes out
+    sim.sim_reset_stats();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_profile_load(0, dds.dds_freq_ftw(1000000u), 0, 0x3FFFu));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.sim_stats().frames);
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(1000000u),
+                            static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::PROFILE0)));
+
+    // Scope left without commit(): same rollback, nothing pulsed
+    sim.sim_reset_stats();
+    {
+        AD9910::Transaction t(dds);
+        stage_everything(t, dds, 20000000u);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(1000000u),
+                            static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::PROFILE0)));
+    TEST_ASSERT_EQUAL_HEX32(dds.dds_freq_ftw(1000000u), static_cast<uint32_t>(dds.dds_regs().profile[0].val));
+}
+
+// --- TEST : FTW / POW that went out before the failure are re-staged too
+void test_driver_transaction_rollback_ftw_pow() {
+    FlakySpiBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    {
+        AD9910::Transaction t(dds);
+        t.write<ad9910_reg::FTW>(ad9910_reg::FTW::value_type(0x12345678u))
+         .write<ad9910_reg::POW>(ad9910_reg::POW::value_type(0x4000u));
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, t.commit());
+    }
+    TEST_ASSERT_EQUAL_HEX32(0x12345678u, static_cast<uint32_t>(sim.sim_active(ad9910_reg::Reg::FTW)));
+    sim.fail_in(2);                                                     // the commit burst
+    sim.sim_reset_stats();
+
+    {
+        AD9910::Transaction t(dds);
+        t.write<ad9910_reg::FTW>(ad9910_reg::FTW::value_type(0x0BADF00Du))
+         .write<ad9910_reg::POW>(ad9910_reg::POW::value_type(0x1234u));
+        stage_everything(t, dds, 1000000u);                             // spills FTW / POW first
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_HW_ERROR, t.commit());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL_HEX64(sim.sim_active(ad9910_reg::Reg::FTW), sim.sim_staged(ad9910_reg::Reg::FTW));
+    TEST_ASSERT_EQUAL_HEX64(sim.sim_active(ad9910_reg::Reg::POW), sim.sim_staged(ad9910_reg::Reg::POW));
+    TEST_ASSERT_EQUAL_HEX32(0x12345678u, static_cast<uint32_t>(dds.dds_regs().ftw.val));
+
+    // Scope left without commit(): same for the plain abort
+    {
+        AD9910::Transaction t(dds);
+        t.write<ad9910_reg::POW>(ad9910_reg::POW::value_type(0x2222u));
+        stage_everything(t, dds, 20000000u);
+    }
+    TEST_ASSERT_EQUAL_HEX64(sim.sim_active(ad9910_reg::Reg::POW), sim.sim_staged(ad9910_reg::Reg::POW));
+
+    // RAM is not staged: a transaction can't take it back, so it refuses it
+    const uint8_t word[4] = {};
+    AD9910::Transaction t(dds);
+    t.write_raw(static_cast<uint8_t>(ad9910_reg::Reg::RAM), word, 4);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, t.commit());
+}
+
+// --- TEST : a failed CFR2 write leaves the internal timer in charge of the pin
+void test_driver_io_update_external_bus_error() {
+    FlakySpiBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_io_update_internal(1000000u));
+
+    sim.fail_in(1);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_HW_ERROR, dds.dds_io_update_external());
+    TEST_ASSERT_TRUE(dds.dds_io_update_is_internal());
+    TEST_ASSERT_FALSE(sim.sim_pin_output(pin(DdsPin::IO_UPDATE)));
+    TEST_ASSERT_EQUAL_HEX32(0x00800000u, static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::CFR2)) & 0x00800000u);
+
+    // CFR2 images written meanwhile still keep the mode; the retry goes through
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_freq_sweep(1000000u, 2000000u, 10u, SweepTimeFormat::Milliseconds, true));
+    TEST_ASSERT_EQUAL_HEX32(0x00800000u, static_cast<uint32_t>(sim.sim_staged(ad9910_reg::Reg::CFR2)) & 0x00800000u);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_io_update_external());
+    TEST_ASSERT_FALSE(dds.dds_io_update_is_internal());
+    TEST_ASSERT_TRUE(sim.sim_pin_output(pin(DdsPin::IO_UPDATE)));
+}
+
+// --- TEST : four chips on one bus: one reset, one set-up burst, one IO_UPDATE for all
+void test_array_init_sync_broadcast() {
+    const pin_t cs[4] = { make_pin(PORT_A, 0, PIN_OUTPUT), make_pin(PORT_A, 1, PIN_OUTPUT),
+                          make_pin(PORT_A, 2, PIN_OUTPUT), make_pin(PORT_A, 3, PIN_OUTPUT) };
+    NativeSimBus   bus(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), cs[0]));
+    NativeSimBoard ch1(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), cs[1]));
+    NativeSimBoard ch2(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), cs[2]));
+    NativeSimBoard ch3(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), cs[3]));
+    bus.sim_attach(ch1); bus.sim_attach(ch2); bus.sim_attach(ch3);
+
+    DdsArray arr(bus, kSpiCfg, make_ctx(), cs, 4);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, arr.init());
+    for (uint8_t i = 0; i < 4; ++i) {
+        NativeSimBoard& chip = bus.sim_chip(i);
+        TEST_ASSERT_EQUAL_HEX32(0x00000002u, chip.sim_active(ad9910_reg::Reg::CFR1));
+        TEST_ASSERT_EQUAL_HEX32(0x01000020u, chip.sim_active(ad9910_reg::Reg::CFR2));
+        TEST_ASSERT_EQUAL_UINT32(1,  chip.sim_stats().master_resets);
+        TEST_ASSERT_EQUAL_UINT32(1,  chip.sim_stats().io_updates);
+        TEST_ASSERT_EQUAL_UINT32(20, chip.sim_stats().spi_bytes);                     // the single-chip set-up, once
+        TEST_ASSERT_TRUE(arr[i].is_initialized());
+    }
+
+    // Receivers everywhere in one transfer, the generator on channel 0 only
+    using MS = ad9910_reg::MULTICHIP_SYNC;
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, arr.sync(4));
+    TEST_ASSERT_EQUAL_HEX32(MS::sync(true, 4, 0, 0).val, bus.sim_active(ad9910_reg::Reg::MULTICHIP_SYNC));
+    for (uint8_t i = 1; i < 4; ++i)
+        TEST_ASSERT_EQUAL_HEX32(MS::sync(false, 0, 0, 0).val, bus.sim_chip(i).sim_active(ad9910_reg::Reg::MULTICHIP_SYNC));
+    for (uint8_t i = 0; i < 4; ++i)                                                   // accumulators released
+        TEST_ASSERT_EQUAL_HEX32(0x00000002u, bus.sim_chip(i).sim_active(ad9910_reg::Reg::CFR1));
+
+    // Per-channel phases staged separately, latched on one shared edge
+    bus.sim_reset_stats_all();
+    for (uint8_t i = 0; i < 4; ++i)
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK,
+                          arr[i].dds_profile_load(0, arr[i].dds_freq_ftw(10000000u), uint16_t(i * 0x4000u), 0x3FFFu, false));
+    TEST_ASSERT_EQUAL_UINT32(0, bus.sim_stats().io_updates);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, arr.io_update());
+    for (uint8_t i = 0; i < 4; ++i) {
+        NativeSimBoard& chip = bus.sim_chip(i);
+        TEST_ASSERT_EQUAL_UINT32(1, chip.sim_stats().io_updates);
+        TEST_ASSERT_EQUAL_UINT32(1, chip.sim_stats().frames);                         // only its own frame
+        TEST_ASSERT_EQUAL_HEX16(uint16_t(i * 0x4000u), uint16_t(chip.sim_active(ad9910_reg::Reg::PROFILE0) >> 32));
+    }
+
+    // Identical content for all: one transfer, dropped when every channel holds it
+    bus.sim_reset_stats_all();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, arr.broadcast<ad9910_reg::ASF>(ad9910_reg::ASF::value_type(0x00FF0000u)));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, arr.broadcast<ad9910_reg::ASF>(ad9910_reg::ASF::value_type(0x00FF0000u)));
+    TEST_ASSERT_EQUAL_UINT32(5, bus.sim_stats().spi_bytes);
+    for (uint8_t i = 0; i < 4; ++i)
+        TEST_ASSERT_EQUAL_HEX32(0x00FF0000u, bus.sim_chip(i).sim_staged(ad9910_reg::Reg::ASF));
+}
+
+// Board without port access (hw_pin_port): CS lines can only be driven one by one
+class NoPortBus : public NativeSimBus {
+public:
+    using NativeSimBus::NativeSimBus;
+    bool hw_pin_port(uint8_t, uint8_t*, uint32_t*) const override { return false; }
+};
+
+// Four channels on bus (built with cs[0]), one ASF broadcast after init; bus-side stats
+static NativeSimBoard::sim_stats_t array_broadcast_asf(NativeSimBus& bus, const pin_t* cs) {
+    NativeSimBoard ch1(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), cs[1]));
+    NativeSimBoard ch2(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), cs[2]));
+    NativeSimBoard ch3(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), cs[3]));
+    bus.sim_attach(ch1); bus.sim_attach(ch2); bus.sim_attach(ch3);
+
+    DdsArray arr(bus, kSpiCfg, make_ctx(), cs, 4);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, arr.init());
+    bus.sim_reset_stats_all();
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, arr.broadcast<ad9910_reg::ASF>(ad9910_reg::ASF::value_type(0x00FF0000u)));
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, arr.io_update());
+    for (uint8_t i = 0; i < 4; ++i) {
+        TEST_ASSERT_EQUAL_HEX32(0x00FF0000u, bus.sim_chip(i).sim_active(ad9910_reg::Reg::ASF));
+        TEST_ASSERT_EQUAL_UINT32(1, bus.sim_chip(i).sim_stats().frames);
+        TEST_ASSERT_EQUAL_UINT32(0, bus.sim_chip(i).sim_stats().protocol_errors);
+    }
+    return bus.sim_stats();
+}
+
+// --- TEST : CS lines on one port go low in one write; other layouts still reach every chip
+void test_array_broadcast_cs_ports() {
+    // Same port: one masked write each way, the frame clocked once
+    const pin_t same[4] = { make_pin(PORT_A, 0, PIN_OUTPUT), make_pin(PORT_A, 1, PIN_OUTPUT),
+                            make_pin(PORT_A, 2, PIN_OUTPUT), make_pin(PORT_A, 3, PIN_OUTPUT) };
+    NativeSimBus bus_a(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), same[0]));
+    NativeSimBoard::sim_stats_t st = array_broadcast_asf(bus_a, same);
+    TEST_ASSERT_EQUAL_UINT32(5, st.spi_bytes);
+    TEST_ASSERT_EQUAL_UINT32(2, st.port_writes);
+    TEST_ASSERT_EQUAL_UINT32(1, st.cs_assertions);
+    TEST_ASSERT_EQUAL_UINT32(1, st.io_updates);
+
+    // Two ports: one write per port, still a single transfer
+    const pin_t split[4] = { make_pin(PORT_A, 0, PIN_OUTPUT), make_pin(PORT_A, 1, PIN_OUTPUT),
+                             make_pin(PORT_C, 0, PIN_OUTPUT), make_pin(PORT_C, 1, PIN_OUTPUT) };
+    NativeSimBus bus_b(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), split[0]));
+    st = array_broadcast_asf(bus_b, split);
+    TEST_ASSERT_EQUAL_UINT32(5, st.spi_bytes);
+    TEST_ASSERT_EQUAL_UINT32(4, st.port_writes);
+
+    // No port access: channel after channel, 4× the traffic, one IO_UPDATE all the same
+    NoPortBus bus_c(NativeSimBoard::kMegaCostModel, dds_pins_with_cs(dds_pins(), same[0]));
+    st = array_broadcast_asf(bus_c, same);
+    TEST_ASSERT_EQUAL_UINT32(20, st.spi_bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, st.port_writes);
+    TEST_ASSERT_EQUAL_UINT32(1, st.cs_assertions);                                    // channel 0's own CS
+    TEST_ASSERT_EQUAL_UINT32(1, st.io_updates);
+}
+
+// ----------------------------------------
+//                MAIN BODY
+// ----------------------------------------
+void setUp()   {}
+void tearDown(){}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+
+    // --- DECODER
+    RUN_TEST(test_sim_power_on_defaults);
+    RUN_TEST(test_sim_staged_then_active);
+    RUN_TEST(test_sim_back_to_back_frames);
+    RUN_TEST(test_sim_register_read);
+    RUN_TEST(test_sim_protocol_error_and_reset);
+    RUN_TEST(test_sim_port_write_masked);
+
+    // --- AD9910 DRIVER
+    RUN_TEST(test_driver_init_registers);
+    RUN_TEST(test_driver_freq_out_profile);
+    RUN_TEST(test_driver_cache_skips_identical_write);
+    RUN_TEST(test_driver_cache_sweep_repeat);
+    RUN_TEST(test_driver_cache_invalidate);
+    RUN_TEST(test_driver_two_instances);
+    RUN_TEST(test_driver_sweep_single_burst);
+    RUN_TEST(test_driver_sweep_report);
+    RUN_TEST(test_driver_freq_ramp_asymmetric);
+    RUN_TEST(test_driver_drg_phase_ampl);
+    RUN_TEST(test_reg_batch_drop_and_overflow);
+    RUN_TEST(test_driver_profile_select_ports);
+    RUN_TEST(test_driver_io_update_modes);
+    RUN_TEST(test_driver_io_update_external_bus_error);
+
+    // --- PROFILE SEQUENCER
+    RUN_TEST(test_profile_sequencer_playback);
+    RUN_TEST(test_profile_sequencer_underrun);
+    RUN_TEST(test_profile_sequencer_stream);
+
+    // --- SWEEP PLAN
+    RUN_TEST(test_sweep_plan_compile);
+    RUN_TEST(test_sweep_plan_drover_rearm);
+    RUN_TEST(test_sweep_plan_drover_short_segment);
+
+    // --- RAM PLAYBACK
+    RUN_TEST(test_driver_ram_load_and_play);
+    RUN_TEST(test_driver_raw_write_tracks_bank);
+
+    // --- OSK
+    RUN_TEST(test_driver_osk_auto_and_manual);
+
+    // --- PARALLEL PORT
+    RUN_TEST(test_driver_parallel_stream);
+
+    // --- TRANSACTIONS
+    RUN_TEST(test_driver_transaction_single_update);
+    RUN_TEST(test_driver_transaction_rollback);
+    RUN_TEST(test_driver_transaction_rollback_ftw_pow);
+
+    // --- ARRAY
+    RUN_TEST(test_array_init_sync_broadcast);
+    RUN_TEST(test_array_broadcast_cs_ports);
+
+    return UNITY_END();
+}
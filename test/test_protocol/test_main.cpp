@@ -0,0 +1,331 @@
+#include <unity.h>
+#include <cstring>
+#include <cstdio>
+#include "boards/native/board_native_sim.h"
+#include "dds/ad9910/ad9910.h"
+#include "common/sim_fixture.h"
+#include "dds/ad9910/ad9910_profile_sequencer.h"
+#include "dds/dds_protocol.h"
+
+// Command
+// pio test -e native -f test_protocol
+
+// Host encoder → NativeSimBoard serial loopback → SerialLink / unpack on the board side,
+// replies back the same way.
+
+// ----------------------------------------
+//               FIXTURE
+// ----------------------------------------
+using namespace dds_proto;
+
+static constexpr size_t kTableLen = 1000;
+
+// Board side of an FTW upload: every frame is unpacked into table and answered
+static size_t board_service(NativeSimBoard& sim, uint32_t* table, size_t* filled) {
+    SerialLink link(sim);
+    size_t frames = 0;
+    while (link.poll()) {
+        const FrameDecoder& f = link.frame();
+        dds_status_t s = dds_status_t::DDS_INVALID_PARAM;
+        if (f.cmd() == CMD_FTW_LIST) s = unpack_words(f.payload(), f.len(), table, kTableLen, filled);
+        link.reply(f.cmd(), s);
+        ++frames;
+    }
+    return frames;
+}
+
+// Host side: decodes every reply the board sent so far
+static void host_replies(NativeSimBoard& sim, size_t* acks, size_t* naks) {
+    uint8_t buf[64];
+    FrameDecoder dec;
+    size_t n;
+    while ((n = sim.sim_serial_take(buf, sizeof(buf))) != 0)
+        for (size_t i = 0; i < n; ++i)
+            if (dec.push(buf[i]) == FrameDecoder::result_t::FRAME) {
+                if (dec.cmd() == CMD_ACK) ++*acks;
+                if (dec.cmd() == CMD_NAK) ++*naks;
+            }
+}
+
+
+// ----------------------------------------
+//                 TESTS
+// ----------------------------------------
+
+// --- TEST : CRC-16/CCITT-FALSE check value, little-endian framing
+void test_frame_layout() {
+    const uint8_t check[] = { '1','2','3','4','5','6','7','8','9' };
+    TEST_ASSERT_EQUAL_HEX16(0x29B1u, crc16(check, sizeof(check)));
+
+    uint8_t out[MAX_FRAME];
+    const size_t n = encode_profile(3, 0x11223344u, 0x5566u, 0x3FFFu, out, sizeof(out));
+    TEST_ASSERT_EQUAL_UINT32(PROFILE_BYTES + OVERHEAD, n);
+    const uint8_t head[] = { SYNC, PROFILE_BYTES, CMD_PROFILE, 3, 0x44, 0x33, 0x22, 0x11, 0x66, 0x55, 0xFF, 0x3F };
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(head, out, sizeof(head));
+    TEST_ASSERT_EQUAL_HEX16(crc16(out + 1, n - 3), get_u16(out + n - 2));
+
+    TEST_ASSERT_EQUAL_UINT32(0, encode(CMD_PING, nullptr, 0, out, OVERHEAD - 1));           // doesn't fit
+    TEST_ASSERT_EQUAL_UINT32(0, encode(CMD_PING, out, MAX_PAYLOAD + 1, out, sizeof(out)));  // too long
+}
+
+// --- TEST : 1000-point FTW table through the loopback, chunked by the encoder
+void test_upload_ftw_table() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    static uint32_t freqs[kTableLen], sent[kTableLen], table[kTableLen];
+    size_t ascii_bytes = 0;
+    for (size_t i = 0; i < kTableLen; ++i) {
+        freqs[i] = 1000000u + static_cast<uint32_t>(i) * 397000u;
+        char s[16];
+        ascii_bytes += static_cast<size_t>(std::snprintf(s, sizeof(s), "%lu,", static_cast<unsigned long>(freqs[i])));
+    }
+    dds.dds_freq_ftw_batch(freqs, sent, kTableLen);
+    std::memset(table, 0, sizeof(table));
+
+    size_t wire = 0, frames = 0, filled = 0, acks = 0, naks = 0;
+    for (size_t off = 0; off < kTableLen; ) {
+        uint8_t frame[MAX_FRAME];
+        size_t used = 0;
+        const size_t n = encode_words(CMD_FTW_LIST, static_cast<uint16_t>(off), sent + off, kTableLen - off,
+                                      frame, sizeof(frame), &used);
+        TEST_ASSERT_NOT_EQUAL(0, n);
+        sim.sim_serial_inject(frame, n);
+        wire += n;
+        off  += used;
+        ++frames;
+    }
+    TEST_ASSERT_EQUAL_UINT32((kTableLen + WORDS_MAX - 1) / WORDS_MAX, frames);
+    TEST_ASSERT_EQUAL_UINT32(frames, board_service(sim, table, &filled));
+    TEST_ASSERT_EQUAL_UINT32(0, sim.sim_serial_rx_pending());
+    TEST_ASSERT_EQUAL_UINT32(kTableLen, filled);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(sent, table, kTableLen);
+
+    host_replies(sim, &acks, &naks);
+    TEST_ASSERT_EQUAL_UINT32(frames, acks);
+    TEST_ASSERT_EQUAL_UINT32(0, naks);
+
+    // 4 bytes + framing per point against the OG decimal text, which the board still had to atol
+    TEST_ASSERT_EQUAL_UINT32(kTableLen * 4 + frames * (OVERHEAD + WORD_HEADER), wire);
+    TEST_ASSERT_LESS_THAN(ascii_bytes / 2, wire);
+    TEST_ASSERT_EQUAL_UINT32(wire, sim.sim_stats().serial_rx_bytes);
+}
+
+// --- TEST : a corrupted frame is dropped and counted, the stream resynchronises on the next one
+void test_crc_error_resync() {
+    NativeSimBoard sim;
+    uint32_t words[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint32_t table[kTableLen] = {};
+    uint8_t  a[MAX_FRAME], b[MAX_FRAME];
+    size_t used;
+    const size_t na = encode_words(CMD_FTW_LIST, 0, words,     4, a, sizeof(a), &used);
+    const size_t nb = encode_words(CMD_FTW_LIST, 4, words + 4, 4, b, sizeof(b), &used);
+    a[5] ^= 0x10u;                                      // bit flip in the payload
+
+    const uint8_t noise[] = { 0x00, SYNC, 0xFF };       // stray SYNC followed by an invalid length
+    sim.sim_serial_inject(noise, sizeof(noise));
+    sim.sim_serial_inject(a, na);
+    sim.sim_serial_inject(b, nb);
+
+    SerialLink link(sim);
+    TEST_ASSERT_TRUE(link.poll());
+    TEST_ASSERT_EQUAL_HEX8(CMD_FTW_LIST, link.frame().cmd());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, unpack_words(link.frame().payload(), link.frame().len(), table, kTableLen));
+    TEST_ASSERT_FALSE(link.poll());
+    TEST_ASSERT_EQUAL_UINT32(2, link.frame().errors());
+    TEST_ASSERT_EQUAL_UINT32(0, table[0]);              // frame a never applied
+    TEST_ASSERT_EQUAL_UINT32(5, table[4]);
+    TEST_ASSERT_EQUAL_UINT32(8, table[7]);
+
+    // Past the end of the table: rejected, table untouched, NAK carries the status
+    uint32_t w = 0xDEADBEEFu;
+    const size_t nc = encode_words(CMD_FTW_LIST, kTableLen, &w, 1, a, sizeof(a), &used);
+    sim.sim_serial_inject(a, nc);
+    TEST_ASSERT_TRUE(link.poll());
+    const dds_status_t s = unpack_words(link.frame().payload(), link.frame().len(), table, kTableLen);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_INVALID_PARAM, s);
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, link.reply(link.frame().cmd(), s));
+
+    uint8_t r[16];
+    const size_t nr = sim.sim_serial_take(r, sizeof(r));
+    FrameDecoder dec;
+    FrameDecoder::result_t res = FrameDecoder::result_t::PENDING;
+    for (size_t i = 0; i < nr; ++i) res = dec.push(r[i]);
+    TEST_ASSERT_EQUAL(FrameDecoder::result_t::FRAME, res);
+    TEST_ASSERT_EQUAL_HEX8(CMD_NAK, dec.cmd());
+    TEST_ASSERT_EQUAL_HEX8(CMD_FTW_LIST, dec.payload()[0]);
+    TEST_ASSERT_EQUAL_INT8(static_cast<int8_t>(dds_status_t::DDS_INVALID_PARAM), static_cast<int8_t>(dec.payload()[1]));
+}
+
+// --- TEST : a byte lost inside a frame costs that frame only, even with a SYNC in its payload
+void test_lost_byte_resync() {
+    NativeSimBoard sim;
+    // 0x0000F0A5 puts SYNC + LEN 240 inside a's payload: a false frame start once a is dropped
+    const uint32_t words[12] = { 0x11111111u, 0x0000F0A5u, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    uint32_t table[kTableLen] = {};
+    uint8_t  a[MAX_FRAME], b[MAX_FRAME], c[MAX_FRAME];
+    size_t used, filled = 0;
+    const size_t na = encode_words(CMD_FTW_LIST, 0, words,     4, a, sizeof(a), &used);
+    const size_t nb = encode_words(CMD_FTW_LIST, 4, words + 4, 4, b, sizeof(b), &used);
+    const size_t nc = encode_words(CMD_FTW_LIST, 8, words + 8, 4, c, sizeof(c), &used);
+
+    sim.sim_serial_inject(a, 5);                        // a[5] (first payload word byte) lost
+    sim.sim_serial_inject(a + 6, na - 6);
+    sim.sim_serial_inject(b, nb);
+    sim.sim_serial_inject(c, nc);
+
+    TEST_ASSERT_EQUAL_UINT32(2, board_service(sim, table, &filled));    // b and c
+    TEST_ASSERT_EQUAL_UINT32(0, table[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, table[1]);
+    for (uint8_t i = 4; i < 12; ++i) TEST_ASSERT_EQUAL_UINT32(words[i], table[i]);
+    TEST_ASSERT_EQUAL_UINT32(12, filled);
+
+    // Same stream byte by byte through one decoder: nothing left pending at the end
+    FrameDecoder dec;
+    uint8_t stream[3 * MAX_FRAME];
+    size_t n = 0;
+    for (size_t i = 0; i < na; ++i) if (i != 5) stream[n++] = a[i];
+    for (size_t i = 0; i < nb; ++i) stream[n++] = b[i];
+    for (size_t i = 0; i < nc; ++i) stream[n++] = c[i];
+    size_t frames = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (dec.push(stream[i]) != FrameDecoder::result_t::FRAME) continue;
+        ++frames;
+        while (dec.resume() == FrameDecoder::result_t::FRAME) ++frames;
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, frames);
+    TEST_ASSERT_EQUAL_HEX8(CMD_FTW_LIST, dec.cmd());
+    TEST_ASSERT_EQUAL_UINT16(8, get_u16(dec.payload()));
+}
+
+// --- TEST : entries land in ProfileSequencer::entry_t as is, PROFILE frame goes to the chip
+void test_entries_and_profile() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    static ProfileSequencer::entry_t src[40], dst[40];
+    for (size_t i = 0; i < 40; ++i)
+        src[i] = { 0x01000000u * static_cast<uint32_t>(i) + 7u, static_cast<uint16_t>(i * 3u), static_cast<uint16_t>(0x3FFFu - i) };
+    std::memset(dst, 0, sizeof(dst));
+
+    for (size_t off = 0; off < 40; ) {
+        uint8_t frame[MAX_FRAME];
+        size_t used = 0;
+        const size_t n = encode_entries(static_cast<uint16_t>(off), src + off, 40 - off, frame, sizeof(frame), &used);
+        sim.sim_serial_inject(frame, n);
+        off += used;
+    }
+    uint8_t frame[MAX_FRAME];
+    sim.sim_serial_inject(frame, encode_profile(5, 0x12345678u, 0x1111u, 0x2222u, frame, sizeof(frame)));
+
+    SerialLink link(sim);
+    size_t filled = 0;
+    while (link.poll()) {
+        const FrameDecoder& f = link.frame();
+        if (f.cmd() == CMD_ENTRY_LIST) {
+            TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, unpack_entries(f.payload(), f.len(), dst, 40, &filled));
+        } else {
+            TEST_ASSERT_EQUAL_HEX8(CMD_PROFILE, f.cmd());
+            TEST_ASSERT_EQUAL_UINT8(PROFILE_BYTES, f.len());
+            const uint8_t* p = f.payload();
+            TEST_ASSERT_EQUAL(dds_status_t::DDS_OK,
+                              dds.dds_profile_load(p[0], get_u32(p + 1), get_u16(p + 5), get_u16(p + 7)));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(40, filled);
+    for (size_t i = 0; i < 40; ++i) {
+        TEST_ASSERT_EQUAL_HEX32(src[i].ftw, dst[i].ftw);
+        TEST_ASSERT_EQUAL_HEX16(src[i].pow, dst[i].pow);
+        TEST_ASSERT_EQUAL_HEX16(src[i].asf, dst[i].asf);
+    }
+
+    const uint64_t p5 = sim.sim_active(ad9910_reg::Reg::PROFILE5);
+    TEST_ASSERT_EQUAL_HEX32(0x12345678u, static_cast<uint32_t>(p5));
+    TEST_ASSERT_EQUAL_HEX16(0x1111u, static_cast<uint16_t>(p5 >> 32));
+    TEST_ASSERT_EQUAL_HEX16(0x2222u, static_cast<uint16_t>(p5 >> 48) & 0x3FFFu);
+}
+
+// --- TEST : ENTRY_LIST frames feed the sequencer's ring, a full ring NAKs and the host resends
+void test_stream_entries_over_serial() {
+    NativeSimBoard sim;
+    AD9910 dds(sim, kSpiCfg, make_ctx());
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, dds.dds_init());
+
+    constexpr size_t N = 200;
+    static ProfileSequencer::entry_t src[N];
+    for (size_t i = 0; i < N; ++i) src[i] = { 0x02000000u + static_cast<uint32_t>(i) * 4099u, 0, 0x3FFFu };
+
+    static ProfileSequencer::stream_t ring;
+    ring.reset();
+    ProfileSequencer seq(dds);
+    SerialLink link(sim);
+    size_t next = 0, sent = 0, acked = 0, acks = 0, naks = 0;
+
+    // Host: one frame in flight, from the first entry not ACKed yet
+    auto host_send = [&]() {
+        uint8_t frame[MAX_FRAME];
+        const size_t n = encode_entries(static_cast<uint16_t>(acked), src + acked, N - acked, frame, sizeof(frame), &sent);
+        sim.sim_serial_inject(frame, n);
+    };
+    auto host_poll = [&]() {
+        const size_t a = acks;
+        host_replies(sim, &acks, &naks);
+        if (acks != a) acked += sent;
+    };
+    auto board_rx = [&]() {
+        while (link.poll()) {
+            const FrameDecoder& f = link.frame();
+            const dds_status_t s = (f.cmd() == CMD_ENTRY_LIST)
+                ? ProfileSequencer::stream_entries(ring, f.payload(), f.len(), &next)
+                : dds_status_t::DDS_INVALID_PARAM;
+            link.reply(f.cmd(), s);
+        }
+    };
+
+    for (int k = 0; k < 3; ++k) { host_send(); board_rx(); host_poll(); }   // 30 + 30, third doesn't fit
+    TEST_ASSERT_EQUAL_UINT32(60, next);
+    TEST_ASSERT_EQUAL_UINT32(60, acked);
+    TEST_ASSERT_EQUAL_UINT32(1, naks);
+    TEST_ASSERT_EQUAL_UINT8(1, ring.overruns());
+
+    TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.start(ring, N));
+    for (size_t i = 1; i < N; ++i) {
+        if (acked < N) { host_send(); board_rx(); host_poll(); }
+        while (seq.service()) {}
+        TEST_ASSERT_EQUAL(dds_status_t::DDS_OK, seq.trigger());
+        const auto reg = static_cast<ad9910_reg::Reg>(ad9910_reg::PROFILE0::address + i % 8);
+        TEST_ASSERT_EQUAL_HEX32(src[i].ftw, static_cast<uint32_t>(sim.sim_active(reg)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(N, next);
+    TEST_ASSERT_EQUAL_UINT32(0, seq.underruns());
+    TEST_ASSERT_GREATER_THAN(1u, naks);                                      // paced by the ring
+
+    // Out of order: rejected, nothing taken
+    uint8_t frame[MAX_FRAME];
+    size_t used = 0;
+    sim.sim_serial_inject(frame, encode_entries(5, src, 2, frame, sizeof(frame), &used));
+    const size_t n0 = naks;
+    board_rx(); host_poll();
+    TEST_ASSERT_EQUAL_UINT32(n0 + 1, naks);
+    TEST_ASSERT_EQUAL_UINT32(N, next);
+}
+
+
+// ----------------------------------------
+//                 MAIN
+// ----------------------------------------
+void setUp()   {}
+void tearDown(){}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_layout);
+    RUN_TEST(test_upload_ftw_table);
+    RUN_TEST(test_crc_error_resync);
+    RUN_TEST(test_lost_byte_resync);
+    RUN_TEST(test_entries_and_profile);
+    RUN_TEST(test_stream_entries_over_serial);
+    return UNITY_END();
+}
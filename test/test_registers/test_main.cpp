@@ -1,6 +1,7 @@
 #include <unity.h>
 #include <registers.h>  
 #include <array>    
+#include "dds/ad9910/ad9910_registers.h"
 
 // Command 
 // pio test -e native -f test_registers
@@ -356,18 +357,18 @@ static void test_regvalue_various_lengths_random(void)
 void test_regvalue_field_extract_insert(void)
 {
     // set bit0 = 1  => raw pattern 0b00000001
-    Reg9::insert<F_BIT0>(0xF1);
-    TEST_ASSERT_EQUAL_UINT8(0x01, Reg9::extract<F_BIT0>());
-    TEST_ASSERT_EQUAL_UINT64(0x0000000000000001ull, Reg9::shadow.val);
-
-    Reg9::insert<F_MODE>(0x08);
-    TEST_ASSERT_EQUAL_UINT8(0x01, Reg9::extract<F_BIT0>());
-    TEST_ASSERT_EQUAL_UINT8(0x08, Reg9::extract<F_MODE>());
-    TEST_ASSERT_EQUAL_UINT64(0x0000000000000801ull, Reg9::shadow.val);
-
-    Reg9::insert<F_BYTE2>(0xAB);
-    TEST_ASSERT_EQUAL_UINT8(0xAB, Reg9::extract<F_BYTE2>());
-    TEST_ASSERT_EQUAL_UINT64(0x0000000000AB0801ull, Reg9::shadow.val);
+    auto v = Reg9::insert<F_BIT0>(0xF1);
+    TEST_ASSERT_EQUAL_UINT8(0x01, Reg9::extract<F_BIT0>(v));
+    TEST_ASSERT_EQUAL_UINT64(0x0000000000000001ull, v.val);
+
+    v = Reg9::insert<F_MODE>(0x08, v);
+    TEST_ASSERT_EQUAL_UINT8(0x01, Reg9::extract<F_BIT0>(v));
+    TEST_ASSERT_EQUAL_UINT8(0x08, Reg9::extract<F_MODE>(v));
+    TEST_ASSERT_EQUAL_UINT64(0x0000000000000801ull, v.val);
+
+    v = Reg9::insert<F_BYTE2>(0xAB, v);
+    TEST_ASSERT_EQUAL_UINT8(0xAB, Reg9::extract<F_BYTE2>(v));
+    TEST_ASSERT_EQUAL_UINT64(0x0000000000AB0801ull, v.val);
 }
 
 
@@ -375,19 +376,19 @@ void test_regvalue_field_extract_insert(void)
 void test_regvalue_field_clear(void)
 {
     // set fields using raw bit patterns
-    Reg10::insert<F_BIT0>(0x01);   
-    Reg10::insert<F_MODE>(0x0C);    
-    Reg10::insert<F_BYTE2>(0xAA); 
+    auto v = Reg10::insert<F_BIT0>(0x01);
+    v = Reg10::insert<F_MODE>(0x0C, v);
+    v = Reg10::insert<F_BYTE2>(0xAA, v);
 
-    TEST_ASSERT_EQUAL_UINT8(0x01, Reg10::extract<F_BIT0>());
-    TEST_ASSERT_EQUAL_UINT8(0x0C, Reg10::extract<F_MODE>());
-    TEST_ASSERT_EQUAL_UINT8(0xAA, Reg10::extract<F_BYTE2>());
+    TEST_ASSERT_EQUAL_UINT8(0x01, Reg10::extract<F_BIT0>(v));
+    TEST_ASSERT_EQUAL_UINT8(0x0C, Reg10::extract<F_MODE>(v));
+    TEST_ASSERT_EQUAL_UINT8(0xAA, Reg10::extract<F_BYTE2>(v));
 
-    Reg10::clear<F_MODE>();
+    v = Reg10::clear<F_MODE>(v);
 
-    TEST_ASSERT_EQUAL_UINT8(0x01, Reg10::extract<F_BIT0>());   // unchanged
-    TEST_ASSERT_EQUAL_UINT8(0x00, Reg10::extract<F_MODE>());   // cleared
-    TEST_ASSERT_EQUAL_UINT8(0xAA, Reg10::extract<F_BYTE2>());  // unchanged
+    TEST_ASSERT_EQUAL_UINT8(0x01, Reg10::extract<F_BIT0>(v));   // unchanged
+    TEST_ASSERT_EQUAL_UINT8(0x00, Reg10::extract<F_MODE>(v));   // cleared
+    TEST_ASSERT_EQUAL_UINT8(0xAA, Reg10::extract<F_BYTE2>(v));  // unchanged
 }
 
 void test_reg_value_set(){
@@ -395,10 +396,88 @@ void test_reg_value_set(){
     using RegA = Register<0x00, 2>; 
     using F_ENABLE = Field<3>; // single bit at bit 3
 
-    RegA::set<F_ENABLE>(true);
-    TEST_ASSERT_EQUAL_UINT16(0x0008, RegA::shadow.val);
-    RegA::set<F_ENABLE>(false);
-    TEST_ASSERT_EQUAL_UINT16(0x0000, RegA::shadow.val);
+    auto v = RegA::set<F_ENABLE>(true);
+    TEST_ASSERT_EQUAL_UINT16(0x0008, v.val);
+    v = RegA::set<F_ENABLE>(false, v);
+    TEST_ASSERT_EQUAL_UINT16(0x0000, v.val);
+}
+
+// --- TEST: values are independent (no hidden per-address state) and compose at compile time
+void test_reg_value_independent(){
+
+    using RegA = Register<0x00, 2>;
+    using F_ENABLE = Field<3>;
+
+    auto a = RegA::set<F_ENABLE>(true);
+    auto b = RegA::insert<F_BYTE2>(0xAA);       // same address, separate image
+    TEST_ASSERT_EQUAL_UINT16(0x0008, a.val);
+    TEST_ASSERT_EQUAL_UINT16(0x0000, b.val);    // byte 2 masked out of a 2-byte register
+
+    constexpr auto c = Reg4::set<F_BIT0>(true, Reg4::insert<F_MODE>(0x0C));
+    static_assert(c.val == 0x0C01u, "constexpr composition");
+    static_assert(Reg4::extract<F_MODE>(c) == 0x0C, "constexpr extract");
+    TEST_ASSERT_EQUAL_UINT32(0x0C01u, c.val);
+}
+
+// ----------------------------------------
+//            COMPILE-TIME FRAMES
+// ----------------------------------------
+// Every check below is a static_assert: if any of it needed run-time work the file
+// would not compile. The RUN_TEST only re-reads the folded constants.
+namespace fx = ad9910_reg::fixed;
+
+// std::array::operator== is only constexpr from C++20
+template<size_t N>
+constexpr bool same(const std::array<uint8_t,N>& a, const std::array<uint8_t,N>& b) {
+    for (size_t i = 0; i < N; i++) if (a[i] != b[i]) return false;
+    return true;
+}
+
+static_assert(same(fx::CFR1_DEFAULTS.frame, std::array<uint8_t,5>{0x00, 0x00,0x00,0x00,0x02}), "CFR1: SDIO input only");
+static_assert(same(fx::CFR1_DRG_SETUP.frame, std::array<uint8_t,5>{0x00, 0x00,0x00,0x40,0x02}), "CFR1: + autoclear DRG acc");
+static_assert(same(fx::CFR2_DEFAULTS.frame, std::array<uint8_t,5>{0x01, 0x01,0x00,0x00,0x20}), "CFR2: ASF from profile, sync val. disable");
+static_assert(same(fx::CFR2_DRG_FREQ.frame, std::array<uint8_t,5>{0x01, 0x00,0x08,0x00,0x00}), "CFR2: DRG enable, freq dest");
+static_assert(same(fx::CFR2_DRG_FREQ_CONT.frame, std::array<uint8_t,5>{0x01, 0x00,0x0E,0x00,0x00}), "CFR2: + no-dwell high/low");
+static_assert(same(ad9910_reg::CFR2::frame(ad9910_reg::CFR2::drg_freq(false, true)), std::array<uint8_t,5>{0x01, 0x00,0x0A,0x00,0x00}), "CFR2: no-dwell low only");
+static_assert(same(fx::AUX_DAC_FSC_NORMAL.frame, std::array<uint8_t,5>{0x03, 0x00,0x00,0x00,0x7F}), "AUX_DAC: FSC 0x7F");
+static_assert(same(fx::AUX_DAC_FSC_HIGH.frame, std::array<uint8_t,5>{0x03, 0x00,0x00,0x00,0xFF}), "AUX_DAC: FSC 0xFF");
+
+constexpr auto kCfr3PllOn = ad9910_reg::CFR3::frame(ad9910_reg::CFR3::default_pll_on(
+                                false, 40, ad9910_reg::CFR3::VcoSel::VCO5, ad9910_reg::CFR3::IcpCode::u387));
+static_assert(same(kCfr3PllOn, std::array<uint8_t,5>{0x02, 0x05,0x38,0x41,0x28}), "CFR3: VCO5, 387 uA, PLL on, N=20");
+
+constexpr auto kProfile = ad9910_reg::PROFILE3::frame(ad9910_reg::PROFILE3::single_tone(0x12345678u, 0xABCDu, 0xFFFFu));
+static_assert(same(kProfile, std::array<uint8_t,9>{0x11, 0x3F,0xFF,0xAB,0xCD,0x12,0x34,0x56,0x78}), "PROFILE3 single tone");
+
+constexpr auto kRamProfile = ad9910_reg::RAM_PROFILE::frame(ad9910_reg::RAM_PROFILE::set_ram(
+                                0x155, 0x3FF, 0x1234, ad9910_reg::RAM_PROFILE::Mode::ContinuousRecirculate, true));
+static_assert(same(kRamProfile, std::array<uint8_t,9>{0x0E, 0x00,0x12,0x34,0xFF,0xC0,0x55,0x40,0x24}), "RAM profile 0");
+static_assert(ad9910_reg::CFR1::ram_enable(ad9910_reg::CFR1::RamDest::Polar, ad9910_reg::CFR1::defaults()).val == 0xE0000002u,
+              "CFR1: RAM on, polar");
+static_assert(ad9910_reg::ram_word::polar(0xABCDu, 0x3FFFu) == 0xABCDFFFCu, "RAM word: POW [31:16], ASF [15:2]");
+
+static_assert(same(pack_be<4>(0x11223344u), std::array<uint8_t,4>{0x11,0x22,0x33,0x44}), "pack_be is constexpr");
+
+// --- TEST : fixed frames are compile-time constants
+void test_fixed_frames_constexpr(){
+    constexpr uint8_t cfr2_hdr = fx::CFR2_DEFAULTS.frame[0];
+    TEST_ASSERT_EQUAL_HEX8(0x01, cfr2_hdr);
+    TEST_ASSERT_EQUAL_UINT32(5, fx::CFR1_DEFAULTS.frame.size());
+    TEST_ASSERT_EQUAL_HEX32(0x00000002u, fx::CFR1_DEFAULTS.value.val);
+    TEST_ASSERT_EQUAL_HEX8(0x28, kCfr3PllOn[4]);
+    TEST_ASSERT_EQUAL_HEX8(0x78, kProfile[8]);
+}
+
+// --- TEST : RAM profile start/end addresses survive the split fields
+void test_ram_profile_addresses(){
+    using RP = ad9910_reg::RAM_PROFILE;
+    const uint16_t cases[][2] = { {0, 0}, {1, 2}, {0x155, 0x3FF}, {1023, 1023} };
+    for (const auto& c : cases) {
+        const auto v = RP::set_ram(c[0], c[1], 1, RP::Mode::RampUp);
+        TEST_ASSERT_EQUAL_UINT16(c[0], RP::start_of(v));
+        TEST_ASSERT_EQUAL_UINT16(c[1], RP::end_of(v));
+        TEST_ASSERT_EQUAL_HEX8(0x01, RP::extract<RP::MODE>(v));
+    }
 }
 
 // ----------------------------------------
@@ -435,6 +514,11 @@ int main(int, char**) {
     RUN_TEST(test_regvalue_field_extract_insert);
     RUN_TEST(test_regvalue_field_clear);
     RUN_TEST(test_reg_value_set);
+    RUN_TEST(test_reg_value_independent);
+
+    // --- COMPILE-TIME FRAMES
+    RUN_TEST(test_fixed_frames_constexpr);
+    RUN_TEST(test_ram_profile_addresses);
 
 
     return UNITY_END();